@@ -0,0 +1,90 @@
+/*
+Compares bst_snapshot_search() with walking the original tree through
+bst_search() on the same keys.
+
+Build from the project root:
+    gcc -O2 -o bst_snapshot_bench bench/bst_snapshot_bench.c bst.c pool.c -I. -pthread
+Run:
+    ./bst_snapshot_bench [nodes] [lookups]
+*/
+#include "dshelp.h"
+#include <time.h>
+
+/**
+ * xorshift32, so every run and platform sees the same keys
+ */
+static unsigned nextRandom(unsigned* state) {
+    unsigned x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static double secondsSince(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char** argv) {
+    int nodes = argc > 1 ? atoi(argv[1]) : 1000000;
+    int lookups = argc > 2 ? atoi(argv[2]) : 10000000;
+    if (nodes <= 0 || lookups <= 0) {
+        printf("Usage: %s [nodes] [lookups]\n", argv[0]);
+        return 1;
+    }
+
+    // Random insertion order gives the usual unbalanced, pointer-chasing tree
+    unsigned state = 12345;
+    tree* root = NULL;
+    for (int i = 0; i < nodes; i++) {
+        root = bst_insert(root, (int)(nextRandom(&state) % (2u * nodes)));
+    }
+    BstSnapshot* snap = bst_snapshot(root);
+    if (!snap) {
+        printf("Error: Snapshot allocation failed\n");
+        bst_clear(root);
+        return 1;
+    }
+
+    // Half the keys hit on average; both searches see the same sequence
+    int* keys = (int*)malloc(lookups * sizeof(int));
+    if (!keys) {
+        printf("Error: Memory allocation failed for keys\n");
+        bst_snapshot_free(snap);
+        bst_clear(root);
+        return 1;
+    }
+    for (int i = 0; i < lookups; i++) {
+        keys[i] = (int)(nextRandom(&state) % (2u * nodes));
+    }
+
+    long long treeHits = 0, snapHits = 0;
+    clock_t start = clock();
+    for (int i = 0; i < lookups; i++) {
+        treeHits += bst_search(root, keys[i]) != NULL;
+    }
+    double treeTime = secondsSince(start);
+
+    start = clock();
+    for (int i = 0; i < lookups; i++) {
+        snapHits += bst_snapshot_search(snap, keys[i]) != NULL;
+    }
+    double snapTime = secondsSince(start);
+
+    printf("%d distinct keys, %d lookups\n", snap->count, lookups);
+    printf("bst_search           %8.3f s  %7.1f ns/lookup  %lld hits\n",
+           treeTime, treeTime * 1e9 / lookups, treeHits);
+    printf("bst_snapshot_search  %8.3f s  %7.1f ns/lookup  %lld hits\n",
+           snapTime, snapTime * 1e9 / lookups, snapHits);
+    if (snapTime > 0) {
+        printf("speedup              %8.2fx\n", treeTime / snapTime);
+    }
+    if (treeHits != snapHits) {
+        printf("Error: Hit counts differ\n");
+    }
+
+    free(keys);
+    bst_snapshot_free(snap);
+    bst_clear(root);
+    return treeHits == snapHits ? 0 : 1;
+}
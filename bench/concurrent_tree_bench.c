@@ -0,0 +1,170 @@
+/*
+Mixed read/write throughput of the lock-free ConcurrentTree against the
+plain bst_* functions behind one pthread mutex.
+
+Build from the project root:
+    gcc -O2 -o concurrent_tree_bench bench/concurrent_tree_bench.c bst.c pool.c lockfree.c -I. -pthread
+Run:
+    ./concurrent_tree_bench [threads] [ops per thread] [keys] [update %]
+*/
+#include "dshelp.h"
+#include <pthread.h>
+#include <time.h>
+
+/*What every worker needs; one copy shared by all of them*/
+typedef struct BenchConfig {
+    int opsPerThread;
+    int keys;                    // Keys are drawn from [0, keys)
+    int updatePercent;           // Split evenly between inserts and deletes
+    ConcurrentTree* concurrent;  // Set for the lock-free run
+    tree* plain;                 // Used with plainLock otherwise
+    pthread_mutex_t plainLock;
+} BenchConfig;
+
+/*Per-thread arguments*/
+typedef struct BenchWorker {
+    BenchConfig* config;
+    unsigned seed;
+    pthread_t thread;
+} BenchWorker;
+
+/**
+ * xorshift32, so every run and platform sees the same keys
+ */
+static unsigned nextRandom(unsigned* state) {
+    unsigned x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static double wallSeconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static void* concurrentWorker(void* arg) {
+    BenchWorker* worker = (BenchWorker*)arg;
+    BenchConfig* config = worker->config;
+    unsigned state = worker->seed;
+    for (int i = 0; i < config->opsPerThread; i++) {
+        int key = (int)(nextRandom(&state) % (unsigned)config->keys);
+        int roll = (int)(nextRandom(&state) % 200u);
+        if (roll >= 2 * config->updatePercent) {
+            bst_concurrent_search(config->concurrent, key);
+        } else if (roll & 1) {
+            bst_concurrent_insert(config->concurrent, key);
+        } else {
+            bst_concurrent_Delete_Node(config->concurrent, key);
+        }
+    }
+    return NULL;
+}
+
+static void* mutexWorker(void* arg) {
+    BenchWorker* worker = (BenchWorker*)arg;
+    BenchConfig* config = worker->config;
+    unsigned state = worker->seed;
+    for (int i = 0; i < config->opsPerThread; i++) {
+        int key = (int)(nextRandom(&state) % (unsigned)config->keys);
+        int roll = (int)(nextRandom(&state) % 200u);
+        pthread_mutex_lock(&config->plainLock);
+        // Same set semantics as the concurrent tree: no duplicates, and
+        // no "NODE NOT FOUND" output for missing keys
+        bool present = bst_search(config->plain, key) != NULL;
+        if (roll >= 2 * config->updatePercent) {
+            // Lookup only
+        } else if (roll & 1) {
+            if (!present) {
+                config->plain = bst_insert(config->plain, key);
+            }
+        } else if (present) {
+            config->plain = bst_Delete_Node(config->plain, key);
+        }
+        pthread_mutex_unlock(&config->plainLock);
+    }
+    return NULL;
+}
+
+/**
+ * Runs body on every worker and returns the wall-clock seconds taken,
+ * or a negative value if a thread could not be started
+ */
+static double runWorkers(BenchWorker* workers, int threads, void* (*body)(void*)) {
+    double start = wallSeconds();
+    int started = 0;
+    while (started < threads &&
+           pthread_create(&workers[started].thread, NULL, body, &workers[started]) == 0) {
+        started++;
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    return started == threads ? wallSeconds() - start : -1.0;
+}
+
+int main(int argc, char** argv) {
+    int threads = argc > 1 ? atoi(argv[1]) : 4;
+    int opsPerThread = argc > 2 ? atoi(argv[2]) : 1000000;
+    int keys = argc > 3 ? atoi(argv[3]) : 100000;
+    int updatePercent = argc > 4 ? atoi(argv[4]) : 5;
+    if (threads <= 0 || opsPerThread <= 0 || keys <= 0 || updatePercent < 0 || updatePercent > 100) {
+        printf("Usage: %s [threads] [ops per thread] [keys] [update %%]\n", argv[0]);
+        return 1;
+    }
+
+    BenchConfig config;
+    config.opsPerThread = opsPerThread;
+    config.keys = keys;
+    config.updatePercent = updatePercent;
+    config.concurrent = bst_concurrent_create();
+    config.plain = NULL;
+    pthread_mutex_init(&config.plainLock, NULL);
+    BenchWorker* workers = (BenchWorker*)malloc(threads * sizeof(BenchWorker));
+    if (!config.concurrent || !workers) {
+        printf("Error: Memory allocation failed for benchmark\n");
+        bst_concurrent_free(config.concurrent);
+        free(workers);
+        return 1;
+    }
+
+    // Both trees start half full, filled in the same random order
+    unsigned state = 12345;
+    for (int i = 0; i < keys / 2; i++) {
+        int key = (int)(nextRandom(&state) % (unsigned)keys);
+        if (bst_concurrent_insert(config.concurrent, key) == 0) {
+            config.plain = bst_insert(config.plain, key);
+        }
+    }
+    for (int i = 0; i < threads; i++) {
+        workers[i].config = &config;
+        workers[i].seed = 2654435761u * (unsigned)(i + 1);
+    }
+
+    double concurrentTime = runWorkers(workers, threads, concurrentWorker);
+    double mutexTime = runWorkers(workers, threads, mutexWorker);
+    int status = 0;
+    if (concurrentTime < 0 || mutexTime < 0) {
+        printf("Error: Could not start %d threads\n", threads);
+        status = 1;
+    } else {
+        double totalOps = (double)threads * opsPerThread;
+        printf("%d threads, %d ops each, %d keys, %d%% updates\n",
+               threads, opsPerThread, keys, updatePercent);
+        printf("bst_concurrent_*     %8.3f s  %7.2f Mops/s\n",
+               concurrentTime, totalOps / concurrentTime / 1e6);
+        printf("bst_* + mutex        %8.3f s  %7.2f Mops/s\n",
+               mutexTime, totalOps / mutexTime / 1e6);
+        if (concurrentTime > 0) {
+            printf("speedup              %8.2fx\n", mutexTime / concurrentTime);
+        }
+    }
+
+    free(workers);
+    pthread_mutex_destroy(&config.plainLock);
+    bst_clear(config.plain);
+    bst_concurrent_free(config.concurrent);
+    return status;
+}
@@ -0,0 +1,437 @@
+#include "dshelp.h"
+#include <string.h>
+/* ====================
+ * B+ TREE
+ * ==================== */
+
+// Every node fills two cache lines
+#define BPTREE_NODE_BYTES 128
+// Tree height never gets near this: each inner node has at least 5 children
+#define BPTREE_MAX_HEIGHT 32
+
+/*Fields shared by leaves and inner nodes*/
+typedef struct BPlusHeader {
+    int count;               // Keys in the node
+    int leaf;                // Non-zero for leaves
+} BPlusHeader;
+
+#define BPTREE_LEAF_KEYS \
+    ((BPTREE_NODE_BYTES - sizeof(BPlusHeader) - sizeof(void*)) / sizeof(int))
+#define BPTREE_INNER_KEYS \
+    ((BPTREE_NODE_BYTES - sizeof(BPlusHeader) - sizeof(void*)) / (sizeof(int) + sizeof(void*)))
+#define BPTREE_LEAF_MIN ((int)BPTREE_LEAF_KEYS / 2)
+#define BPTREE_INNER_MIN ((int)BPTREE_INNER_KEYS / 2)
+
+/*Leaf: sorted keys plus the next leaf, for ordered scans*/
+typedef struct BPlusLeaf {
+    BPlusHeader header;
+    int keys[BPTREE_LEAF_KEYS];
+    struct BPlusLeaf* next;
+} BPlusLeaf;
+
+/*Inner node: children[i] holds the keys in [keys[i - 1], keys[i])*/
+typedef struct BPlusInner {
+    BPlusHeader header;
+    int keys[BPTREE_INNER_KEYS];
+    void* children[BPTREE_INNER_KEYS + 1];
+} BPlusInner;
+
+struct BPlusTree {
+    void* root;              // Always allocated; an empty tree is an empty leaf
+    int height;              // Levels of inner nodes above the leaves
+    int size;                // Number of keys
+    NodePool* pool;          // Owns every node
+};
+
+static bool isLeafNode(void* node) {
+    return ((BPlusHeader*)node)->leaf != 0;
+}
+
+/**
+ * Child index of an inner node that key is routed to
+ */
+static int routeKey(const BPlusInner* inner, int key) {
+    int i = countLessInts(inner->keys, inner->header.count, key);
+    if (i < inner->header.count && inner->keys[i] == key) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * Takes one node from the tree's pool, as a leaf or an inner node
+ */
+static void* allocBPlusNode(BPlusTree* tree, bool leaf) {
+    BPlusHeader* node = (BPlusHeader*)poolAlloc(tree->pool, BPTREE_NODE_BYTES);
+    if (node) {
+        node->count = 0;
+        node->leaf = leaf;
+        if (leaf) {
+            ((BPlusLeaf*)node)->next = NULL;
+        }
+    }
+    return node;
+}
+
+/**
+ * Creates an empty B+ tree
+ */
+BPlusTree* bptree_create(void) {
+    BPlusTree* tree = (BPlusTree*)malloc(sizeof(BPlusTree));
+    if (!tree) {
+        printf("Error: Memory allocation failed for B+ tree\n");
+        return NULL;
+    }
+    tree->pool = createNodePool(BPTREE_NODE_BYTES, 0);
+    tree->root = tree->pool ? allocBPlusNode(tree, true) : NULL;
+    if (!tree->root) {
+        printf("Error: Memory allocation failed for B+ tree\n");
+        freeNodePool(tree->pool);
+        free(tree);
+        return NULL;
+    }
+    tree->height = 0;
+    tree->size = 0;
+    return tree;
+}
+
+/**
+ * Returns true if key is in the tree
+ */
+bool bptree_search(BPlusTree* tree, int key) {
+    void* node = tree->root;
+    while (!isLeafNode(node)) {
+        BPlusInner* inner = (BPlusInner*)node;
+        node = inner->children[routeKey(inner, key)];
+    }
+    BPlusLeaf* leaf = (BPlusLeaf*)node;
+    int i = countLessInts(leaf->keys, leaf->header.count, key);
+    return i < leaf->header.count && leaf->keys[i] == key;
+}
+
+/**
+ * Inserts key below node; on a split the new right sibling and its
+ * separator are passed up through upKey / upNode
+ * Returns -1 for a duplicate, 0 when done, 1 when the caller must
+ * link upNode; spare holds enough preallocated nodes for every split
+ */
+static int insertBelow(void* node, int key, int* upKey, void** upNode, void** spare, int* numSpare) {
+    if (isLeafNode(node)) {
+        BPlusLeaf* leaf = (BPlusLeaf*)node;
+        int count = leaf->header.count;
+        int pos = countLessInts(leaf->keys, count, key);
+        if (pos < count && leaf->keys[pos] == key) {
+            return -1;
+        }
+        if (count < (int)BPTREE_LEAF_KEYS) {
+            memmove(&leaf->keys[pos + 1], &leaf->keys[pos], (count - pos) * sizeof(int));
+            leaf->keys[pos] = key;
+            leaf->header.count++;
+            return 0;
+        }
+
+        // Split the full leaf in half, then insert into the proper side
+        BPlusLeaf* right = (BPlusLeaf*)spare[--*numSpare];
+        right->header.leaf = 1;
+        int half = count / 2;
+        right->header.count = count - half;
+        memcpy(right->keys, &leaf->keys[half], right->header.count * sizeof(int));
+        leaf->header.count = half;
+        right->next = leaf->next;
+        leaf->next = right;
+        BPlusLeaf* target = pos <= half ? leaf : right;
+        int at = pos <= half ? pos : pos - half;
+        memmove(&target->keys[at + 1], &target->keys[at], (target->header.count - at) * sizeof(int));
+        target->keys[at] = key;
+        target->header.count++;
+        *upKey = right->keys[0];
+        *upNode = right;
+        return 1;
+    }
+
+    BPlusInner* inner = (BPlusInner*)node;
+    int child = routeKey(inner, key);
+    int childKey;
+    void* childNode;
+    int result = insertBelow(inner->children[child], key, &childKey, &childNode, spare, numSpare);
+    if (result != 1) {
+        return result;
+    }
+
+    int count = inner->header.count;
+    if (count < (int)BPTREE_INNER_KEYS) {
+        memmove(&inner->keys[child + 1], &inner->keys[child], (count - child) * sizeof(int));
+        memmove(&inner->children[child + 2], &inner->children[child + 1],
+                (count - child) * sizeof(void*));
+        inner->keys[child] = childKey;
+        inner->children[child + 1] = childNode;
+        inner->header.count++;
+        return 0;
+    }
+
+    // Split the full inner node around its middle key, which moves up
+    int keys[BPTREE_INNER_KEYS + 1];
+    void* children[BPTREE_INNER_KEYS + 2];
+    memcpy(keys, inner->keys, child * sizeof(int));
+    keys[child] = childKey;
+    memcpy(&keys[child + 1], &inner->keys[child], (count - child) * sizeof(int));
+    memcpy(children, inner->children, (child + 1) * sizeof(void*));
+    children[child + 1] = childNode;
+    memcpy(&children[child + 2], &inner->children[child + 1], (count - child) * sizeof(void*));
+
+    BPlusInner* right = (BPlusInner*)spare[--*numSpare];
+    right->header.leaf = 0;
+    int total = count + 1;
+    int mid = total / 2;
+    inner->header.count = mid;
+    memcpy(inner->keys, keys, mid * sizeof(int));
+    memcpy(inner->children, children, (mid + 1) * sizeof(void*));
+    right->header.count = total - mid - 1;
+    memcpy(right->keys, &keys[mid + 1], right->header.count * sizeof(int));
+    memcpy(right->children, &children[mid + 1], (right->header.count + 1) * sizeof(void*));
+    *upKey = keys[mid];
+    *upNode = right;
+    return 1;
+}
+
+/**
+ * Inserts key, splitting full nodes on the way back up
+ * Returns 0, or -1 if key is already present or allocation fails
+ */
+int bptree_insert(BPlusTree* tree, int key) {
+    // Reserve a node per level plus a new root up front, so a failed
+    // allocation can never leave a half-split tree behind
+    void* spare[BPTREE_MAX_HEIGHT + 2];
+    int numSpare = 0;
+    for (; numSpare < tree->height + 2; numSpare++) {
+        spare[numSpare] = allocBPlusNode(tree, false);
+        if (!spare[numSpare]) {
+            while (numSpare > 0) {
+                poolFree(tree->pool, spare[--numSpare]);
+            }
+            return -1;
+        }
+    }
+
+    int upKey;
+    void* upNode;
+    int result = insertBelow(tree->root, key, &upKey, &upNode, spare, &numSpare);
+    if (result == 1) {
+        BPlusInner* root = (BPlusInner*)spare[--numSpare];
+        root->header.leaf = 0;
+        root->header.count = 1;
+        root->keys[0] = upKey;
+        root->children[0] = tree->root;
+        root->children[1] = upNode;
+        tree->root = root;
+        tree->height++;
+    }
+    while (numSpare > 0) {
+        poolFree(tree->pool, spare[--numSpare]);
+    }
+    if (result < 0) {
+        return -1;
+    }
+    tree->size++;
+    return 0;
+}
+
+/**
+ * Restores the minimum fill of parent->children[i] after a delete,
+ * borrowing from a sibling or merging with it
+ */
+static void fixUnderflow(BPlusTree* tree, BPlusInner* parent, int i) {
+    void* child = parent->children[i];
+    void* left = i > 0 ? parent->children[i - 1] : NULL;
+    void* right = i < parent->header.count ? parent->children[i + 1] : NULL;
+
+    if (isLeafNode(child)) {
+        BPlusLeaf* node = (BPlusLeaf*)child;
+        if (node->header.count >= BPTREE_LEAF_MIN) {
+            return;
+        }
+        BPlusLeaf* l = (BPlusLeaf*)left;
+        BPlusLeaf* r = (BPlusLeaf*)right;
+        if (l && l->header.count > BPTREE_LEAF_MIN) {
+            memmove(&node->keys[1], node->keys, node->header.count * sizeof(int));
+            node->keys[0] = l->keys[--l->header.count];
+            node->header.count++;
+            parent->keys[i - 1] = node->keys[0];
+            return;
+        }
+        if (r && r->header.count > BPTREE_LEAF_MIN) {
+            node->keys[node->header.count++] = r->keys[0];
+            memmove(r->keys, &r->keys[1], --r->header.count * sizeof(int));
+            parent->keys[i] = r->keys[0];
+            return;
+        }
+        // Merge the pair (a, b) around separator j into a
+        int j = l ? i - 1 : i;
+        BPlusLeaf* a = (BPlusLeaf*)parent->children[j];
+        BPlusLeaf* b = (BPlusLeaf*)parent->children[j + 1];
+        memcpy(&a->keys[a->header.count], b->keys, b->header.count * sizeof(int));
+        a->header.count += b->header.count;
+        a->next = b->next;
+        poolFree(tree->pool, b);
+        memmove(&parent->keys[j], &parent->keys[j + 1], (parent->header.count - j - 1) * sizeof(int));
+        memmove(&parent->children[j + 1], &parent->children[j + 2],
+                (parent->header.count - j - 1) * sizeof(void*));
+        parent->header.count--;
+        return;
+    }
+
+    BPlusInner* node = (BPlusInner*)child;
+    if (node->header.count >= BPTREE_INNER_MIN) {
+        return;
+    }
+    BPlusInner* l = (BPlusInner*)left;
+    BPlusInner* r = (BPlusInner*)right;
+    if (l && l->header.count > BPTREE_INNER_MIN) {
+        // Rotate right through the parent separator
+        memmove(&node->keys[1], node->keys, node->header.count * sizeof(int));
+        memmove(&node->children[1], node->children, (node->header.count + 1) * sizeof(void*));
+        node->keys[0] = parent->keys[i - 1];
+        node->children[0] = l->children[l->header.count];
+        node->header.count++;
+        parent->keys[i - 1] = l->keys[--l->header.count];
+        return;
+    }
+    if (r && r->header.count > BPTREE_INNER_MIN) {
+        // Rotate left through the parent separator
+        node->keys[node->header.count] = parent->keys[i];
+        node->children[node->header.count + 1] = r->children[0];
+        node->header.count++;
+        parent->keys[i] = r->keys[0];
+        memmove(r->keys, &r->keys[1], (r->header.count - 1) * sizeof(int));
+        memmove(r->children, &r->children[1], r->header.count * sizeof(void*));
+        r->header.count--;
+        return;
+    }
+    // Merge (a, separator, b) into a
+    int j = l ? i - 1 : i;
+    BPlusInner* a = (BPlusInner*)parent->children[j];
+    BPlusInner* b = (BPlusInner*)parent->children[j + 1];
+    a->keys[a->header.count] = parent->keys[j];
+    memcpy(&a->keys[a->header.count + 1], b->keys, b->header.count * sizeof(int));
+    memcpy(&a->children[a->header.count + 1], b->children, (b->header.count + 1) * sizeof(void*));
+    a->header.count += 1 + b->header.count;
+    poolFree(tree->pool, b);
+    memmove(&parent->keys[j], &parent->keys[j + 1], (parent->header.count - j - 1) * sizeof(int));
+    memmove(&parent->children[j + 1], &parent->children[j + 2],
+            (parent->header.count - j - 1) * sizeof(void*));
+    parent->header.count--;
+}
+
+/**
+ * Deletes key below node; returns 0, or -1 if key is not present
+ */
+static int deleteBelow(BPlusTree* tree, void* node, int key) {
+    if (isLeafNode(node)) {
+        BPlusLeaf* leaf = (BPlusLeaf*)node;
+        int count = leaf->header.count;
+        int pos = countLessInts(leaf->keys, count, key);
+        if (pos == count || leaf->keys[pos] != key) {
+            return -1;
+        }
+        memmove(&leaf->keys[pos], &leaf->keys[pos + 1], (count - pos - 1) * sizeof(int));
+        leaf->header.count--;
+        return 0;
+    }
+
+    BPlusInner* inner = (BPlusInner*)node;
+    int child = routeKey(inner, key);
+    if (deleteBelow(tree, inner->children[child], key) != 0) {
+        return -1;
+    }
+    fixUnderflow(tree, inner, child);
+    return 0;
+}
+
+/**
+ * Deletes key, merging or rebalancing nodes that fall below half full
+ * Returns 0, or -1 if key is not in the tree
+ */
+int bptree_Delete_Node(BPlusTree* tree, int key) {
+    if (deleteBelow(tree, tree->root, key) != 0) {
+        return -1;
+    }
+    // A root left with a single child hands its place to that child
+    if (!isLeafNode(tree->root) && ((BPlusHeader*)tree->root)->count == 0) {
+        void* old = tree->root;
+        tree->root = ((BPlusInner*)old)->children[0];
+        tree->height--;
+        poolFree(tree->pool, old);
+    }
+    tree->size--;
+    return 0;
+}
+
+/**
+ * Leftmost leaf whose keys may include low
+ */
+static BPlusLeaf* findLeaf(BPlusTree* tree, int low) {
+    void* node = tree->root;
+    while (!isLeafNode(node)) {
+        BPlusInner* inner = (BPlusInner*)node;
+        node = inner->children[routeKey(inner, low)];
+    }
+    return (BPlusLeaf*)node;
+}
+
+/**
+ * Stores the keys in [low, high] in ascending order into out
+ * Walks the leaf chain; returns the number of keys in the range,
+ * which may exceed capacity
+ */
+int bptree_storeRange(BPlusTree* tree, int low, int high, int* out, int capacity) {
+    int c = 0;
+    for (BPlusLeaf* leaf = findLeaf(tree, low); leaf; leaf = leaf->next) {
+        int i = countLessInts(leaf->keys, leaf->header.count, low);
+        for (; i < leaf->header.count; i++) {
+            if (leaf->keys[i] > high) {
+                return c;
+            }
+            if (c < capacity) {
+                out[c] = leaf->keys[i];
+            }
+            c++;
+        }
+    }
+    return c;
+}
+
+/**
+ * Stores every key in ascending order, like bst_storeInorder()
+ */
+int bptree_storeInorder(BPlusTree* tree, int* out, int capacity) {
+    return bptree_storeRange(tree, INT_MIN, INT_MAX, out, capacity);
+}
+
+/**
+ * Prints every key in ascending order, like bst_displayInorder()
+ */
+void bptree_displayInorder(BPlusTree* tree) {
+    for (BPlusLeaf* leaf = findLeaf(tree, INT_MIN); leaf; leaf = leaf->next) {
+        for (int i = 0; i < leaf->header.count; i++) {
+            printf("%d ", leaf->keys[i]);
+        }
+    }
+}
+
+/**
+ * Number of keys in the tree, in O(1)
+ */
+int bptree_countNodes(BPlusTree* tree) {
+    return tree->size;
+}
+
+/**
+ * Frees the tree; every node lives in its pool
+ */
+void bptree_free(BPlusTree* tree) {
+    if (!tree) {
+        return;
+    }
+    freeNodePool(tree->pool);
+    free(tree);
+}
@@ -1,27 +1,103 @@
 #include "dshelp.h"
-tree* bst_insert(tree* root, int x)
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define BST_PREFETCH(p) _mm_prefetch((const char*)(p), _MM_HINT_T0)
+#elif defined(__GNUC__)
+#define BST_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define BST_PREFETCH(p) ((void)0)
+#endif
+static void bst_trackInsert(BstTracker* tracker, tree* parent, int depth)
 {
-    if (root == NULL) 
+    BstStats* stats = &tracker->stats;
+    stats->nodes++;
+    stats->leaves++;
+    if (parent != NULL)
     {
-        tree* ptr = (tree*)(malloc(sizeof(tree)));
-        ptr->right = NULL;
-        ptr->data = x;
-        ptr->left = NULL;
-        root = ptr;
-    } 
-    else 
+        // The parent gains a child: leaf -> one child, or one -> two
+        if (parent->left == NULL && parent->right == NULL)
+        {
+            stats->leaves--;
+            stats->oneChild++;
+        }
+        else
+        {
+            stats->oneChild--;
+            stats->twoChildren++;
+        }
+    }
+    tracker->depthSum += depth;
+    if (depth + 1 > stats->height)
+        stats->height = depth + 1;
+}
+static void bst_trackRemoval(BstTracker* tracker, tree* parent, tree* removed, int depth)
+{
+    BstStats* stats = &tracker->stats;
+    stats->nodes--;
+    if (removed->left != NULL || removed->right != NULL)
+    {
+        // Its only child's subtree moves up a level
+        stats->oneChild--;
+        tracker->stale = true;
+        return;
+    }
+    stats->leaves--;
+    if (parent != NULL)
     {
-        if (x < root->data) 
+        if (parent->left != NULL && parent->right != NULL)
         {
-            root->left = bst_insert(root->left, x);  
-        } 
-        else if (x > root->data) 
+            stats->twoChildren--;
+            stats->oneChild++;
+        }
+        else
         {
-            root->right = bst_insert(root->right, x);  
+            stats->oneChild--;
+            stats->leaves++;
         }
     }
+    tracker->depthSum -= depth;
+    if (depth + 1 == stats->height)
+        tracker->stale = true;
+}
+static tree* bst_insertWith(NodePool* pool, BstTracker* tracker, tree* root, int x)
+{
+    tree** link = &root;
+    tree* parent = NULL;
+    int depth = 0;
+    while (*link != NULL) 
+    {
+        parent = *link;
+        if (x < (*link)->data) 
+            link = &(*link)->left;
+        else if (x > (*link)->data) 
+            link = &(*link)->right;
+        else
+            return root;
+        depth++;
+    }
+    tree* ptr = (tree*)(poolAlloc(pool, sizeof(tree)));
+    if (ptr == NULL)
+    {
+        printf("Node Creation Failed\n");
+        return root;
+    }
+    if (tracker != NULL)
+        bst_trackInsert(tracker, parent, depth);
+    ptr->right = NULL;
+    ptr->data = x;
+    ptr->height = 1;
+    ptr->left = NULL;
+    *link = ptr;
     return root;
 }
+tree* bst_insert(tree* root, int x)
+{
+    return bst_insertWith(NULL, NULL, root, x);
+}
+tree* bst_pool_insert(NodePool* pool, tree* root, int x)
+{
+    return bst_insertWith(pool, NULL, root, x);
+}
 void bst_displayPostorder(tree* root) 
 {
     if (root != NULL) 
@@ -49,6 +125,45 @@ void bst_displayInorder(tree* root)
         bst_displayInorder(root->right);  
     }
 }
+static int bst_store(tree* root, int* out, int capacity, int c, int order)
+{
+    if (root != NULL) 
+    {
+        if (order == 0)
+        {
+            if (c < capacity)
+                out[c] = root->data;
+            c = c + 1;
+        }
+        c = bst_store(root->left, out, capacity, c, order);
+        if (order == 1)
+        {
+            if (c < capacity)
+                out[c] = root->data;
+            c = c + 1;
+        }
+        c = bst_store(root->right, out, capacity, c, order);
+        if (order == 2)
+        {
+            if (c < capacity)
+                out[c] = root->data;
+            c = c + 1;
+        }
+    }
+    return c;
+}
+int bst_storePreorder(tree* root, int* out, int capacity)
+{
+    return bst_store(root, out, capacity, 0, 0);
+}
+int bst_storeInorder(tree* root, int* out, int capacity)
+{
+    return bst_store(root, out, capacity, 0, 1);
+}
+int bst_storePostorder(tree* root, int* out, int capacity)
+{
+    return bst_store(root, out, capacity, 0, 2);
+}
 int bst_countNodes(tree* root, int c) 
 {
     if (root != NULL) 
@@ -83,16 +198,173 @@ int bst_Two_child(tree* root, int c)
 }
 int bst_Common_Parent(tree* root, int c) 
 {
-    if (root != NULL) 
+    // A common parent is a node with two children
+    return bst_Two_child(root, c);
+}
+static tree* bst_deleteWith(NodePool* pool, BstTracker* tracker, tree* root, int key)
+{
+    tree** link = &root;
+    tree* parent = NULL;
+    int depth = 0;
+    while (*link != NULL && (*link)->data != key)
     {
-        c = bst_Common_Parent(root->left, c);
-        if (root->right != NULL && root->left != NULL)
-            c = c + 1;
-        c = bst_Common_Parent(root->right, c);
+        parent = *link;
+        if (key < (*link)->data)
+            link = &(*link)->left;
+        else
+            link = &(*link)->right;
+        depth++;
     }
-    return c;
+    tree* node = *link;
+    if (node == NULL)
+    {
+        printf("NODE NOT FOUND\n");
+        return root;
+    }
+
+    if (node->left == NULL || node->right == NULL)
+    {
+        if (tracker != NULL)
+            bst_trackRemoval(tracker, parent, node, depth);
+        *link = node->left != NULL ? node->left : node->right;
+    }
+    else
+    {
+        // Two children: move the inorder successor's value up and unlink it
+        tree** succLink = &node->right;
+        parent = node;
+        depth++;
+        while ((*succLink)->left != NULL)
+        {
+            parent = *succLink;
+            succLink = &(*succLink)->left;
+            depth++;
+        }
+        tree* succ = *succLink;
+        if (tracker != NULL)
+            bst_trackRemoval(tracker, parent, succ, depth);
+        node->data = succ->data;
+        *succLink = succ->right;
+        node = succ;
+    }
+    poolFree(pool, node);
+    return root;
 }
 tree* bst_Delete_Node(tree* root, int key)
+{
+    return bst_deleteWith(NULL, NULL, root, key);
+}
+tree* bst_pool_Delete_Node(NodePool* pool, tree* root, int key)
+{
+    return bst_deleteWith(pool, NULL, root, key);
+}
+tree* bst_clear(tree* root)
+{
+    // Flatten the tree by rotating left children up, freeing as we go
+    while (root != NULL)
+    {
+        if (root->left != NULL)
+        {
+            tree* left = root->left;
+            root->left = left->right;
+            left->right = root;
+            root = left;
+        }
+        else
+        {
+            tree* next = root->right;
+            free(root);
+            root = next;
+        }
+    }
+    return NULL;
+}
+tree* bst_search(tree* root, int key)
+{
+    while (root != NULL && root->data != key)
+    {
+        if (key < root->data)
+            root = root->left;
+        else
+            root = root->right;
+    }
+    return root;
+}
+int bst_height(tree* root)
+{
+    if (root == NULL)
+        return 0;
+    return root->height;
+}
+static void bst_avl_update(tree* root)
+{
+    int lh = bst_height(root->left);
+    int rh = bst_height(root->right);
+    root->height = (lh > rh ? lh : rh) + 1;
+}
+static tree* bst_avl_rotateRight(tree* root)
+{
+    tree* pivot = root->left;
+    root->left = pivot->right;
+    pivot->right = root;
+    bst_avl_update(root);
+    bst_avl_update(pivot);
+    return pivot;
+}
+static tree* bst_avl_rotateLeft(tree* root)
+{
+    tree* pivot = root->right;
+    root->right = pivot->left;
+    pivot->left = root;
+    bst_avl_update(root);
+    bst_avl_update(pivot);
+    return pivot;
+}
+static tree* bst_avl_rebalance(tree* root)
+{
+    bst_avl_update(root);
+    int balance = bst_height(root->left) - bst_height(root->right);
+    if (balance > 1)
+    {
+        // Left-right case becomes left-left after one rotation
+        if (bst_height(root->left->left) < bst_height(root->left->right))
+            root->left = bst_avl_rotateLeft(root->left);
+        return bst_avl_rotateRight(root);
+    }
+    if (balance < -1)
+    {
+        // Right-left case becomes right-right after one rotation
+        if (bst_height(root->right->right) < bst_height(root->right->left))
+            root->right = bst_avl_rotateRight(root->right);
+        return bst_avl_rotateLeft(root);
+    }
+    return root;
+}
+tree* bst_avl_insert(tree* root, int x)
+{
+    if (root == NULL) 
+    {
+        tree* ptr = (tree*)(malloc(sizeof(tree)));
+        if (ptr == NULL)
+        {
+            printf("Node Creation Failed\n");
+            return NULL;
+        }
+        ptr->right = NULL;
+        ptr->data = x;
+        ptr->height = 1;
+        ptr->left = NULL;
+        return ptr;
+    } 
+    if (x < root->data) 
+        root->left = bst_avl_insert(root->left, x);  
+    else if (x > root->data) 
+        root->right = bst_avl_insert(root->right, x);  
+    else
+        return root;
+    return bst_avl_rebalance(root);
+}
+tree* bst_avl_Delete_Node(tree* root, int key)
 {
     if (root == NULL)
     {
@@ -101,9 +373,9 @@ tree* bst_Delete_Node(tree* root, int key)
     }
 
     if (key < root->data)
-        root->left = bst_Delete_Node(root->left, key);
+        root->left = bst_avl_Delete_Node(root->left, key);
     else if (key > root->data)
-        root->right = bst_Delete_Node(root->right, key);
+        root->right = bst_avl_Delete_Node(root->right, key);
     else
     {
         // Node found
@@ -124,7 +396,286 @@ tree* bst_Delete_Node(tree* root, int key)
             temp = temp->left;
 
         root->data = temp->data; 
-        root->right = bst_Delete_Node(root->right, temp->data);
+        root->right = bst_avl_Delete_Node(root->right, temp->data);
+    }
+    return bst_avl_rebalance(root);
+}
+static tree* bst_buildRange(char* block, size_t stride, size_t* used, bool* failed, const int* values, size_t lo, size_t hi)
+{
+    if (lo >= hi)
+        return NULL;
+    size_t mid = lo + (hi - lo) / 2;
+    // Nodes of a block are laid out in preorder, so a search walks forward
+    tree* ptr = block != NULL ? (tree*)(block + (*used)++ * stride) : (tree*)malloc(sizeof(tree));
+    if (ptr == NULL)
+    {
+        *failed = true;
+        return NULL;
+    }
+    ptr->data = values[mid];
+    ptr->left = bst_buildRange(block, stride, used, failed, values, lo, mid);
+    ptr->right = bst_buildRange(block, stride, used, failed, values, mid + 1, hi);
+    int lh = bst_height(ptr->left), rh = bst_height(ptr->right);
+    ptr->height = 1 + (lh > rh ? lh : rh);
+    return ptr;
+}
+static tree* bst_buildWith(NodePool* pool, const int* values, size_t count)
+{
+    size_t unique = count > 0 ? 1 : 0;
+    for (size_t i = 1; i < count; i++)
+    {
+        if (values[i] < values[i - 1])
+        {
+            printf("Values must be in ascending order\n");
+            return NULL;
+        }
+        if (values[i] != values[i - 1])
+            unique++;
+    }
+    // Duplicates are dropped, as bst_insert would, before splitting by rank
+    int* compact = NULL;
+    if (unique < count)
+    {
+        compact = (int*)malloc(unique * sizeof(int));
+        if (compact == NULL)
+        {
+            printf("Node Creation Failed\n");
+            return NULL;
+        }
+        size_t n = 0;
+        for (size_t i = 0; i < count; i++)
+            if (i == 0 || values[i] != values[i - 1])
+                compact[n++] = values[i];
+        values = compact;
+    }
+    char* block = NULL;
+    if (pool != NULL && unique > 0)
+    {
+        block = (char*)poolAllocMany(pool, unique);
+        if (block == NULL)
+        {
+            printf("Node Creation Failed\n");
+            free(compact);
+            return NULL;
+        }
+    }
+    size_t used = 0;
+    bool failed = false;
+    tree* root = bst_buildRange(block, pool != NULL ? pool->objectSize : 0, &used, &failed, values, 0, unique);
+    free(compact);
+    if (failed)
+    {
+        printf("Node Creation Failed\n");
+        return bst_clear(root);
     }
     return root;
 }
+// Nodes are malloc'd one by one; only the pooled variant gets a single block
+tree* bst_build_sorted(const int* values, size_t count)
+{
+    return bst_buildWith(NULL, values, count);
+}
+tree* bst_pool_build_sorted(NodePool* pool, const int* values, size_t count)
+{
+    return bst_buildWith(pool, values, count);
+}
+
+static int bst_walkInorder(tree* root, int* out, int capacity)
+{
+    // Explicit stack: trees built with bst_insert can be as deep as they are large
+    int depth = 0, stackCapacity = 64, c = 0;
+    tree** stack = (tree**)malloc(stackCapacity * sizeof(tree*));
+    if (stack == NULL)
+        return -1;
+    while (root != NULL || depth > 0)
+    {
+        while (root != NULL)
+        {
+            if (depth == stackCapacity)
+            {
+                tree** grown = (tree**)realloc(stack, 2 * stackCapacity * sizeof(tree*));
+                if (grown == NULL)
+                {
+                    free(stack);
+                    return -1;
+                }
+                stack = grown;
+                stackCapacity *= 2;
+            }
+            stack[depth++] = root;
+            root = root->left;
+        }
+        root = stack[--depth];
+        if (c < capacity)
+            out[c] = root->data;
+        c++;
+        root = root->right;
+    }
+    free(stack);
+    return c;
+}
+static const int* bst_fillEytzinger(int* keys, int count, const int* sorted, int k)
+{
+    if (k <= count)
+    {
+        sorted = bst_fillEytzinger(keys, count, sorted, 2 * k);
+        keys[k] = *sorted++;
+        sorted = bst_fillEytzinger(keys, count, sorted, 2 * k + 1);
+    }
+    return sorted;
+}
+BstSnapshot* bst_snapshot(tree* root)
+{
+    int count = bst_walkInorder(root, NULL, 0);
+    BstSnapshot* snap = count >= 0 ? (BstSnapshot*)malloc(sizeof(BstSnapshot)) : NULL;
+    int* sorted = count > 0 ? (int*)malloc(count * sizeof(int)) : NULL;
+    // Index 0 is unused and the array starts on a cache line, so the 16
+    // descendants four levels below any node share one line
+    void* block = snap != NULL ? malloc((count + 1) * sizeof(int) + 63) : NULL;
+    if (block == NULL || (count > 0 && sorted == NULL))
+    {
+        printf("Snapshot Creation Failed\n");
+        free(block);
+        free(snap);
+        free(sorted);
+        return NULL;
+    }
+    snap->block = block;
+    snap->count = count;
+    snap->keys = (int*)(((uintptr_t)snap->block + 63) & ~(uintptr_t)63);
+    if (bst_walkInorder(root, sorted, count) != count)
+    {
+        printf("Snapshot Creation Failed\n");
+        bst_snapshot_free(snap);
+        free(sorted);
+        return NULL;
+    }
+    bst_fillEytzinger(snap->keys, count, sorted, 1);
+    free(sorted);
+    return snap;
+}
+static int bst_trailingOnes(size_t k)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(~(unsigned long long)k);
+#else
+    int n = 0;
+    while (k & 1)
+    {
+        k >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+const int* bst_snapshot_search(const BstSnapshot* snap, int key)
+{
+    const int* keys = snap->keys;
+    int count = snap->count;
+    size_t k = 1;
+    while (k <= (size_t)count)
+    {
+        BST_PREFETCH(keys + 16 * k);
+        k = 2 * k + (keys[k] < key);
+    }
+    // Drop the trailing right turns (and the one left turn before them)
+    // to land on the smallest key not below the search key
+    k >>= bst_trailingOnes(k) + 1;
+    if (k == 0 || keys[k] != key)
+        return NULL;
+    return &keys[k];
+}
+void bst_snapshot_free(BstSnapshot* snap)
+{
+    if (snap != NULL)
+    {
+        free(snap->block);
+        free(snap);
+    }
+}
+static int bst_collectStats(tree* root, BstStats* out, long long* outDepthSum)
+{
+    typedef struct { tree* node; int depth; } BstFrame;
+    int size = 0, capacity = 64;
+    long long depthSum = 0;
+    BstFrame* stack = (BstFrame*)malloc(capacity * sizeof(BstFrame));
+    if (stack == NULL)
+        return -1;
+    BstStats stats = {0, 0, 0, 0, 0, 0.0};
+    if (root != NULL)
+        stack[size++] = (BstFrame){root, 0};
+    while (size > 0)
+    {
+        BstFrame frame = stack[--size];
+        tree* node = frame.node;
+        int children = (node->left != NULL) + (node->right != NULL);
+        stats.nodes++;
+        if (children == 0)
+            stats.leaves++;
+        else if (children == 1)
+            stats.oneChild++;
+        else
+            stats.twoChildren++;
+        if (frame.depth + 1 > stats.height)
+            stats.height = frame.depth + 1;
+        depthSum += frame.depth;
+        if (size + 2 > capacity)
+        {
+            BstFrame* grown = (BstFrame*)realloc(stack, 2 * capacity * sizeof(BstFrame));
+            if (grown == NULL)
+            {
+                free(stack);
+                return -1;
+            }
+            stack = grown;
+            capacity *= 2;
+        }
+        if (node->right != NULL)
+            stack[size++] = (BstFrame){node->right, frame.depth + 1};
+        if (node->left != NULL)
+            stack[size++] = (BstFrame){node->left, frame.depth + 1};
+    }
+    free(stack);
+    stats.averageDepth = stats.nodes > 0 ? (double)depthSum / stats.nodes : 0.0;
+    *out = stats;
+    *outDepthSum = depthSum;
+    return 0;
+}
+int bst_stats(tree* root, BstStats* out)
+{
+    long long depthSum;
+    return bst_collectStats(root, out, &depthSum);
+}
+static int bst_trackerRefresh(BstTracker* tracker, tree* root)
+{
+    if (bst_collectStats(root, &tracker->stats, &tracker->depthSum) != 0)
+        return -1;
+    tracker->stale = false;
+    return 0;
+}
+void bst_tracker_init(BstTracker* tracker, tree* root)
+{
+    tracker->stale = true;
+    bst_trackerRefresh(tracker, root);
+}
+tree* bst_tracked_insert(BstTracker* tracker, tree* root, int x)
+{
+    return bst_insertWith(NULL, tracker, root, x);
+}
+tree* bst_tracked_Delete_Node(BstTracker* tracker, tree* root, int key)
+{
+    return bst_deleteWith(NULL, tracker, root, key);
+}
+// O(1) unless a delete made the tracker stale; then one O(n) recount.
+// Returns NULL if that recount cannot allocate its stack
+const BstStats* bst_tracker_stats(BstTracker* tracker, tree* root)
+{
+    if (tracker->stale)
+    {
+        if (bst_trackerRefresh(tracker, root) != 0)
+            return NULL;
+    }
+    else
+        tracker->stats.averageDepth = tracker->stats.nodes > 0 ? (double)tracker->depthSum / tracker->stats.nodes : 0.0;
+    return &tracker->stats;
+}
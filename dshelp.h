@@ -5,6 +5,31 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <limits.h>
+#include <stdint.h>
+//MEMORY POOL (see pool.c)
+/*Slab allocator for fixed-size nodes; one pool per data structure*/
+typedef struct PoolSlab PoolSlab;
+typedef struct NodePool
+{
+    size_t objectSize;   // Size of every object, rounded to pointer alignment
+    size_t slabObjects;  // Objects carved from each new slab
+    PoolSlab* slabs;     // All slabs, in allocation order
+    PoolSlab* current;   // Slab the cursor points into
+    char* cursor;        // Next unused object in the current slab
+    char* end;           // End of the current slab
+    void* freeList;      // Objects returned with poolFree
+} NodePool;
+NodePool* createNodePool(size_t objectSize, size_t objectsPerSlab);
+void* poolAlloc(NodePool* pool, size_t objectSize);
+void* poolAllocMany(NodePool* pool, size_t count);
+void  poolFree(NodePool* pool, void* object);
+void  poolReset(NodePool* pool);
+void  freeNodePool(NodePool* pool);
+//SEARCH KERNELS (see search.c)
+/*Vectorised linear search over int arrays; -1 when the key is absent*/
+int searchInts(const int* values, int count, int key);
+int searchIntsLast(const int* values, int count, int key);
+int countLessInts(const int* values, int count, int key);
 //LINKED LIST (from llist.h)
 typedef struct Linked_List
 {
@@ -12,28 +37,148 @@ typedef struct Linked_List
     struct Linked_List *next ;
 } list;
 list* llist_insert(list *head);
+list* llist_push(list *head, int x);
+//Mallocs each node so any of them can be freed; llist_pool_push_many takes one block
+//Both push all values or, if allocation fails, none and return head unchanged
+list* llist_push_many(list *head, const int *values, size_t count);
 list* llist_deleteAtLeft(list *head);
 list* llist_deleteLast(list *head);
 void  llist_display(list *head);
+int   llist_store(list *head, int *out, int capacity);
 int   llist_count(list *head);
 void  llist_search(list *head , int key);
+list* llist_find(list *head, int key);
 void  llist_Rdisplay(list *head);
+list* llist_clear(list *head);
+//Pooled variants: nodes come from pool, and poolReset(pool) clears the list
+list* llist_pool_push(NodePool *pool, list *head, int x);
+//Nodes are one contiguous run; the list is unchanged if that run cannot be allocated
+list* llist_pool_push_many(NodePool *pool, list *head, const int *values, size_t count);
+list* llist_pool_deleteAtLeft(NodePool *pool, list *head);
+list* llist_pool_deleteLast(NodePool *pool, list *head);
+//Doubly linked list behind a header that tracks tail and size
+typedef struct Double_Linked_List
+{
+    int data ;
+    struct Double_Linked_List *prev ;
+    struct Double_Linked_List *next ;
+} dlist;
+typedef struct List_Header
+{
+    dlist *head ;
+    dlist *tail ;
+    int size ;
+    NodePool *pool ;   // Source of nodes; NULL uses malloc
+} ListHeader;
+ListHeader* llist_createHeader(NodePool *pool);
+void  llist_header_push(ListHeader *list, int x);
+void  llist_header_append(ListHeader *list, int x);
+void  llist_header_deleteAtLeft(ListHeader *list);
+void  llist_header_deleteLast(ListHeader *list);
+int   llist_header_popFront(ListHeader *list, int *out);
+int   llist_header_popBack(ListHeader *list, int *out);
+int   llist_header_count(ListHeader *list);
+void  llist_header_display(ListHeader *list);
+int   llist_header_store(ListHeader *list, int *out, int capacity);
+void  llist_header_clear(ListHeader *list);
+void  llist_freeHeader(ListHeader *list);
+//Unrolled linked list: each block fills one 64-byte cache line and is allocated
+//64-byte aligned, so it never straddles two lines; free blocks with ulist_clear
+#define ULIST_BLOCK_INTS ((64 - sizeof(void*) - sizeof(int)) / sizeof(int))
+typedef struct Unrolled_Linked_List
+{
+    struct Unrolled_Linked_List *next ;
+    int count ;                      // Values used in this block
+    int data[ULIST_BLOCK_INTS] ;     // Stored back to front: data[count - 1] comes first
+} ulist;
+ulist* ulist_push(ulist *head, int x);
+ulist* ulist_push_many(ulist *head, const int *values, size_t count);
+ulist* ulist_deleteAtLeft(ulist *head);
+ulist* ulist_deleteLast(ulist *head);
+void   ulist_display(ulist *head);
+int    ulist_store(ulist *head, int *out, int capacity);
+int    ulist_count(ulist *head);
+void   ulist_search(ulist *head, int key);
+int    ulist_indexOf(ulist *head, int key);
+ulist* ulist_clear(ulist *head);
 //BINARY SEARCH TREE (from bst.h)
 typedef struct Binary_Search_Tree
 {
     struct Binary_Search_Tree *left;
     int data;
+    int height;   // Subtree height, kept up to date by the bst_avl_* functions
     struct Binary_Search_Tree *right;
 } tree;
 tree* bst_insert(tree* root, int x);
 void  bst_displayPostorder(tree* root);
 void  bst_displayPreorder(tree* root);
 void  bst_displayInorder(tree* root);
+int   bst_storePreorder(tree* root, int* out, int capacity);
+int   bst_storeInorder(tree* root, int* out, int capacity);
+int   bst_storePostorder(tree* root, int* out, int capacity);
 int   bst_countNodes(tree* root, int c);
 int   bst_One_child(tree* root, int c);
 int   bst_Two_child(tree* root, int c);
 int   bst_Common_Parent(tree* root, int c);
+//All of the counts above, plus height and average depth, in one pass
+typedef struct BstStats
+{
+    int nodes;
+    int oneChild;        // Nodes with exactly one child
+    int twoChildren;     // Nodes with two children (the common parents)
+    int leaves;
+    int height;          // Levels, so a single node has height 1
+    double averageDepth; // Mean depth of the nodes, the root being at depth 0
+} BstStats;
+int   bst_stats(tree* root, BstStats* out);
 tree* bst_Delete_Node(tree* root, int key);
+tree* bst_search(tree* root, int key);
+tree* bst_clear(tree* root);
+//Mallocs each node so bst_Delete_Node can free it; bst_pool_build_sorted uses one block
+tree* bst_build_sorted(const int* values, size_t count);
+//Pooled variants: nodes come from pool, and poolReset(pool) clears the tree
+tree* bst_pool_insert(NodePool* pool, tree* root, int x);
+tree* bst_pool_Delete_Node(NodePool* pool, tree* root, int key);
+//Builds the whole tree in a single contiguous node block, laid out in preorder
+tree* bst_pool_build_sorted(NodePool* pool, const int* values, size_t count);
+//Tracked variants keep a BstTracker up to date: bst_tracker_stats is O(1) after
+//inserts, but the first call after a delete recounts in O(n) (NULL if that fails)
+typedef struct BstTracker
+{
+    BstStats stats;
+    long long depthSum;  // Sum of all node depths
+    bool stale;          // Height or depths need a recount after a delete
+} BstTracker;
+void  bst_tracker_init(BstTracker* tracker, tree* root);
+tree* bst_tracked_insert(BstTracker* tracker, tree* root, int x);
+tree* bst_tracked_Delete_Node(BstTracker* tracker, tree* root, int key);
+const BstStats* bst_tracker_stats(BstTracker* tracker, tree* root);
+//Self-balancing (AVL) variants; a tree must be built with these alone
+tree* bst_avl_insert(tree* root, int x);
+tree* bst_avl_Delete_Node(tree* root, int key);
+int   bst_height(tree* root);
+//Read-only snapshot in Eytzinger (BFS) order for fast repeated searches
+typedef struct BstSnapshot
+{
+    int count;     // Number of keys
+    int* keys;     // keys[1..count]; the children of keys[k] are keys[2k] and keys[2k + 1]
+    void* block;   // Allocation behind keys, which is aligned to a cache line
+} BstSnapshot;
+BstSnapshot* bst_snapshot(tree* root);
+const int*   bst_snapshot_search(const BstSnapshot* snap, int key);
+void         bst_snapshot_free(BstSnapshot* snap);
+//B+ TREE (see bptree.c)
+/*Cache-line sized nodes with linked leaves, for large in-memory indexes*/
+typedef struct BPlusTree BPlusTree;
+BPlusTree* bptree_create(void);
+int  bptree_insert(BPlusTree* tree, int key);
+int  bptree_Delete_Node(BPlusTree* tree, int key);
+bool bptree_search(BPlusTree* tree, int key);
+void bptree_displayInorder(BPlusTree* tree);
+int  bptree_storeInorder(BPlusTree* tree, int* out, int capacity);
+int  bptree_storeRange(BPlusTree* tree, int low, int high, int* out, int capacity);
+int  bptree_countNodes(BPlusTree* tree);
+void bptree_free(BPlusTree* tree);
 // GRAPH (from graph.h)
 /*Node structure for adjacency list representation*/
 typedef struct Node {
@@ -41,33 +186,140 @@ typedef struct Node {
     int weight;          // Weight of the edge (for weighted graphs)
     struct Node* next;   // Pointer to next node in the list
 } Node;
+/*Packed vertex set: one bit per vertex in 64-bit words*/
+typedef struct Bitset {
+    uint64_t* words;     // Bit i lives in words[i / 64]; bits past numBits stay 0
+    int numBits;         // Number of vertices the set can hold
+    int numWords;        // (numBits + 63) / 64
+} Bitset;
 /*Graph structure using adjacency list representation*/
 typedef struct Graph {
     int numVertices;     // Total number of vertices in the graph
     Node** adjLists;     // Array of adjacency lists
-    bool* visited;       // Array to track visited vertices (for traversals)
+    Bitset* visited;     // Vertices visited by dfsUtil
+    NodePool* nodePool;  // Owns every adjacency node (NULL = nodes are malloc'd)
 } Graph;
-/*Queue structure for BFS implementation*/
+/*Immutable compressed sparse row (CSR) snapshot of a Graph*/
+typedef struct CsrGraph {
+    int numVertices;     // Total number of vertices in the graph
+    int numEdges;        // Total number of directed edges
+    int* offsets;        // Edges of vertex v are [offsets[v], offsets[v + 1])
+    int* targets;        // Destination vertex of each edge
+    int* weights;        // Weight of each edge
+    void* mapping;       // File mapping the arrays point into (NULL = heap arrays)
+    size_t mappingSize;  // Size of the mapping in bytes
+} CsrGraph;
+/*Queue structure for BFS implementation: a circular buffer that doubles when full*/
 typedef struct Queue {
     int* items;          // Array to store queue elements
-    int front;           // Front index
-    int rear;            // Rear index
-    int capacity;        // Maximum capacity of the queue
+    int head;            // Index of the front element
+    int size;            // Number of elements in the queue
+    int capacity;        // Allocated slots, always a power of two
 } Queue;
+/*Per-query traversal state, so several threads can traverse one graph at once*/
+typedef struct TraversalContext {
+    int numVertices;           // Number of vertices the context can track
+    Bitset* visited;           // Vertices reached by the current traversal
+    int* touchedWords;         // Visited words set since the last reset
+    int numTouched;            // Reset clears just these words
+    int* order;                // Visit order of the last traversal
+    Queue* queue;              // BFS queue, reused across traversals
+    int* stack;                // DFS vertex stack
+    int* cursor;               // DFS next edge index for each stack entry
+    Node** edge;               // DFS next adjacency node for each stack entry
+} TraversalContext;
+/*DFS visitor; parent is -1 for the start vertex*/
+typedef void (*DfsCallback)(int vertex, int parent, void* arg);
+/*Fork-join thread pool used by the parallel algorithms (see threadpool.c)*/
+typedef struct ThreadPool ThreadPool;
+typedef void (*ThreadTask)(void* arg, int threadIndex, int numThreads);
+/*Indexed min-heap keyed by vertex, used as Dijkstra's priority queue*/
+typedef struct MinHeap {
+    int* vertices;       // Heap-ordered array of vertices
+    int* position;       // Index of each vertex in vertices (-1 if absent)
+    int* keys;           // Priority of each vertex (caller-owned, e.g. dist[])
+    int size;            // Number of vertices currently in the heap
+    int capacity;        // Maximum number of vertices
+    int arity;           // Children per node (2 = binary, 4 = 4-ary)
+} MinHeap;
+/*Priority queue strategy used by Dijkstra's algorithm*/
+typedef enum DijkstraMode {
+    DIJKSTRA_DENSE,       // O(V^2) linear scan, best when E is close to V^2
+    DIJKSTRA_BINARY_HEAP, // Indexed binary heap with decrease-key
+    DIJKSTRA_QUAD_HEAP,   // Indexed 4-ary heap with decrease-key
+    DIJKSTRA_LAZY_HEAP    // Binary heap with lazy deletion of stale entries
+} DijkstraMode;
 /*CORE GRAPH FUNCTIONS*/
 Graph* createGraph(int vertices);
 void   addEdge(Graph* graph, int src, int dest, int weight);
 void   removeEdge(Graph* graph, int src, int dest);
 void   displayGraph(Graph* graph);
 void   freeGraph(Graph* graph);
+void   clearGraph(Graph* graph);
 /*GRAPH TRAVERSAL ALGORITHMS*/
 void bfs(Graph* graph, int startVertex);
 void dfs(Graph* graph, int startVertex);
 void dfsUtil(Graph* graph, int vertex);
+void bfsWithContext(Graph* graph, int startVertex, TraversalContext* ctx);
+void dfsWithContext(Graph* graph, int startVertex, TraversalContext* ctx);
+/*RESULT-RETURNING VARIANTS (no stdio, results go to caller buffers)*/
+int  bfsInto(Graph* graph, int startVertex, TraversalContext* ctx,
+             int* order, int* level, int* parent);
+int  dfsInto(Graph* graph, int startVertex, TraversalContext* ctx, int* order, int* parent);
+int  dfsWithCallbacks(Graph* graph, int startVertex, TraversalContext* ctx,
+                      DfsCallback preorder, DfsCallback postorder, void* arg);
+int  dijkstraInto(Graph* graph, int startVertex, DijkstraMode mode, int* dist, int* pred);
 /*SHORTEST PATH ALGORITHMS*/
 void dijkstra(Graph* graph, int startVertex);
+void dijkstraWithMode(Graph* graph, int startVertex, DijkstraMode mode);
+/*CSR GRAPH FUNCTIONS*/
+CsrGraph* createCsrGraph(Graph* graph);
+CsrGraph* createTransposeCsrGraph(Graph* graph);
+void      freeCsrGraph(CsrGraph* csr);
+int       csrFindEdge(const CsrGraph* csr, int src, int dest);
+void      csrBfs(const CsrGraph* csr, int startVertex);
+void      csrDfs(const CsrGraph* csr, int startVertex);
+void      csrBfsWithContext(const CsrGraph* csr, int startVertex, TraversalContext* ctx);
+void      csrDfsWithContext(const CsrGraph* csr, int startVertex, TraversalContext* ctx);
+void      csrDijkstra(const CsrGraph* csr, int startVertex);
+void      csrDijkstraWithMode(const CsrGraph* csr, int startVertex, DijkstraMode mode);
+int       csrBfsInto(const CsrGraph* csr, int startVertex, TraversalContext* ctx,
+                     int* order, int* level, int* parent);
+int       csrDfsInto(const CsrGraph* csr, int startVertex, TraversalContext* ctx,
+                     int* order, int* parent);
+int       csrDfsWithCallbacks(const CsrGraph* csr, int startVertex, TraversalContext* ctx,
+                              DfsCallback preorder, DfsCallback postorder, void* arg);
+int       csrDijkstraInto(const CsrGraph* csr, int startVertex, DijkstraMode mode,
+                          int* dist, int* pred);
+/*BINARY GRAPH FILES (see graphio.c; opened graphs are read-only)*/
+int       saveGraphFile(Graph* graph, const char* path);
+int       saveCsrGraphFile(const CsrGraph* csr, const char* path);
+CsrGraph* openGraphFile(const char* path);
+int       verifyCsrGraph(const CsrGraph* csr);
+void      unmapGraphFile(void* mapping, size_t size);
+/*TEXT GRAPH FILES (see graphio.c; pool may be NULL to parse on the calling thread)*/
+typedef enum GraphFormat {
+    GRAPH_FORMAT_AUTO,           // Detected from the first lines
+    GRAPH_FORMAT_EDGE_LIST,      // "src dest [weight]" per line, 0-based ids
+    GRAPH_FORMAT_MATRIX_MARKET,  // Coordinate MatrixMarket, 1-based ids
+    GRAPH_FORMAT_DIMACS          // "p sp n m" then "a src dest weight", 1-based ids
+} GraphFormat;
+CsrGraph* loadCsrGraphText(const char* path, GraphFormat format, ThreadPool* pool);
+Graph*    loadGraphText(const char* path, GraphFormat format, ThreadPool* pool);
+/*DIRECTION-OPTIMIZING BFS (transpose from createTransposeCsrGraph)*/
+void      csrHybridBfs(const CsrGraph* csr, const CsrGraph* transpose, int startVertex);
+int       csrHybridBfsInto(const CsrGraph* csr, const CsrGraph* transpose, int startVertex,
+                           int* level, int* parent);
+/*PARALLEL GRAPH ALGORITHMS (pool may be NULL to run on the calling thread)*/
+int  parallelBfsInto(Graph* graph, ThreadPool* pool, int startVertex,
+                     int* order, int* level, int* parent);
+int  csrParallelBfsInto(const CsrGraph* csr, ThreadPool* pool, int startVertex,
+                        int* order, int* level, int* parent);
+int  deltaSteppingInto(Graph* graph, ThreadPool* pool, int startVertex, int delta, int* dist);
+int  csrDeltaSteppingInto(const CsrGraph* csr, ThreadPool* pool, int startVertex, int delta,
+                          int* dist);
 /*GRAPH UTILITY FUNCTIONS*/
-Node* createNode(int vertex, int weight);
+Node* createNode(Graph* graph, int vertex, int weight);  // From graph's pool; link only into graph
 Queue* createQueue(int capacity);
 bool   isEmpty(Queue* queue);
 bool   isFull(Queue* queue);
@@ -75,4 +327,48 @@ void   enqueue(Queue* queue, int item);
 int    dequeue(Queue* queue);
 void   freeQueue(Queue* queue);
 int    minDistance(int dist[], bool visited[], int vertices);
+/*BITSET FUNCTIONS*/
+Bitset* createBitset(int numBits);
+bool   bitsetTest(const Bitset* set, int bit);
+bool   bitsetSet(Bitset* set, int bit);
+void   bitsetClear(Bitset* set, int bit);
+void   bitsetClearAll(Bitset* set);
+int    bitsetCount(const Bitset* set);
+int    bitsetNext(const Bitset* set, int from);
+int    bitsetOr(Bitset* dest, const Bitset* src);
+int    bitsetAndNot(Bitset* dest, const Bitset* src);
+void   freeBitset(Bitset* set);
+TraversalContext* createTraversalContext(int vertices);
+void   resetTraversalContext(TraversalContext* ctx);
+bool   isVisited(TraversalContext* ctx, int vertex);
+bool   markVisited(TraversalContext* ctx, int vertex);
+void   freeTraversalContext(TraversalContext* ctx);
+MinHeap* createMinHeap(int capacity, int arity, int* keys);
+bool   heapIsEmpty(MinHeap* heap);
+void   heapDecreaseKey(MinHeap* heap, int vertex, int key);
+int    heapExtractMin(MinHeap* heap);
+void   freeMinHeap(MinHeap* heap);
+ThreadPool* createThreadPool(int numThreads);
+int    threadPoolSize(ThreadPool* pool);
+void   threadPoolRun(ThreadPool* pool, ThreadTask task, void* arg);
+void   freeThreadPool(ThreadPool* pool);
+//LOCK-FREE STRUCTURES (see lockfree.c)
+/*Safe to share between threads; removed nodes are reclaimed with hazard pointers*/
+typedef struct LockFreeStack LockFreeStack;
+typedef struct LockFreeQueue LockFreeQueue;
+LockFreeStack* createLockFreeStack(void);
+int  lockFreePush(LockFreeStack* stack, int x);
+int  lockFreePop(LockFreeStack* stack, int* out);
+void freeLockFreeStack(LockFreeStack* stack);
+LockFreeQueue* createLockFreeQueue(void);
+int  lockFreeEnqueue(LockFreeQueue* queue, int x);
+int  lockFreeDequeue(LockFreeQueue* queue, int* out);
+void freeLockFreeQueue(LockFreeQueue* queue);
+/*Concurrent BST: searches never block, updates are lock-free CASes on single edges*/
+typedef struct ConcurrentTree ConcurrentTree;
+ConcurrentTree* bst_concurrent_create(void);
+bool bst_concurrent_search(ConcurrentTree* tree, int key);
+int  bst_concurrent_insert(ConcurrentTree* tree, int key);
+int  bst_concurrent_Delete_Node(ConcurrentTree* tree, int key);
+void bst_concurrent_free(ConcurrentTree* tree);
 #endif
\ No newline at end of file
@@ -1,13 +1,24 @@
 #include "dshelp.h" // Changed from graph.h
+#include <stdatomic.h>
+#include <string.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 /* ====================
  * UTILITY FUNCTIONS
  * ==================== */
 /**
- * Creates a new node for the adjacency list
- * Allocates memory and initializes the node with given vertex and weight
+ * Creates a new node for the graph's adjacency lists
+ * Takes it from the graph's node pool (malloc if it has none), so the
+ * node may only be linked into that graph, which frees it
  */
-Node* createNode(int vertex, int weight) {
-    Node* newNode = (Node*)malloc(sizeof(Node));
+Node* createNode(Graph* graph, int vertex, int weight) {
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return NULL;
+    }
+    Node* newNode = graph->nodePool ? (Node*)poolAlloc(graph->nodePool, sizeof(Node))
+                                    : (Node*)malloc(sizeof(Node));
     if (!newNode) {
         printf("Error: Memory allocation failed for new node\n");
         return NULL;
@@ -18,60 +29,93 @@ Node* createNode(int vertex, int weight) {
     return newNode;
 }
 /*
-Creates a queue for BFS implementation
-Initializes all queue properties and allocates memory for items array
+Allocates a queue without reporting errors
+Capacity is rounded up to a power of two so indices wrap with a mask
+Returns NULL if memory allocation fails
 */
-Queue* createQueue(int capacity) {
+static Queue* allocQueue(int capacity) {
+    int size = 1;
+    while (size < capacity && size <= INT_MAX / 2) {
+        size <<= 1;
+    }
+    
     Queue* queue = (Queue*)malloc(sizeof(Queue));
     if (!queue) {
-        printf("Error: Memory allocation failed for queue\n");
         return NULL;
     }
     
-    queue->items = (int*)malloc(capacity * sizeof(int));
+    queue->items = (int*)malloc(size * sizeof(int));
     if (!queue->items) {
-        printf("Error: Memory allocation failed for queue items\n");
         free(queue);
         return NULL;
     }
     
-    queue->front = -1;
-    queue->rear = -1;
-    queue->capacity = capacity;
+    queue->head = 0;
+    queue->size = 0;
+    queue->capacity = size;
+    return queue;
+}
+
+/*
+Creates a queue for BFS implementation
+Initializes all queue properties and allocates memory for items array
+*/
+Queue* createQueue(int capacity) {
+    Queue* queue = allocQueue(capacity);
+    if (!queue) {
+        printf("Error: Memory allocation failed for queue\n");
+        return NULL;
+    }
     return queue;
 }
 
 /**
  * Checks if the queue is empty
- * Queue is empty when front is -1 or front > rear
  */
 bool isEmpty(Queue* queue) {
-    return (queue->front == -1 || queue->front > queue->rear);
+    return queue->size == 0;
 }
 
 /**
  * Checks if the queue is full
- * Queue is full when rear reaches capacity - 1
+ * A full queue still accepts items; the next enqueue doubles its capacity
  */
 bool isFull(Queue* queue) {
-    return (queue->rear == queue->capacity - 1);
+    return queue->size == queue->capacity;
+}
+
+/**
+ * Doubles the capacity of a full queue
+ * Items that wrapped around to the start move just past the old end
+ */
+static bool growQueue(Queue* queue) {
+    int capacity = queue->capacity;
+    if (capacity > INT_MAX / 2) {
+        return false;
+    }
+    int* items = (int*)realloc(queue->items, 2 * (size_t)capacity * sizeof(int));
+    if (!items) {
+        return false;
+    }
+    // Slots [0, head) hold the newest items; append them after [head, capacity)
+    memcpy(items + capacity, items, queue->head * sizeof(int));
+    queue->items = items;
+    queue->capacity = 2 * capacity;
+    return true;
 }
 
 /**
  * Adds an element to the rear of the queue
- * Handles the case when queue is initially empty
+ * Grows the buffer when full, so items are only dropped if memory runs out
  */
 void enqueue(Queue* queue, int item) {
-    if (isFull(queue)) {
+    if (isFull(queue) && !growQueue(queue)) {
         printf("Queue is full\n");
         return;
     }
     
-    if (queue->front == -1) {
-        queue->front = 0;  // Initialize front when adding first element
-    }
-    queue->rear++;
-    queue->items[queue->rear] = item;
+    queue->items[(queue->head + queue->size) & (queue->capacity - 1)] = item;
+    queue->size++;
 }
 
 /**
@@ -84,14 +128,9 @@ int dequeue(Queue* queue) {
         return -1;
     }
     
-    int item = queue->items[queue->front];
-    queue->front++;
-    
-    // Reset queue when it becomes empty
-    if (queue->front > queue->rear) {
-        queue->front = queue->rear = -1;
-    }
-    
+    int item = queue->items[queue->head];
+    queue->head = (queue->head + 1) & (queue->capacity - 1);
+    queue->size--;
     return item;
 }
 
@@ -106,13 +145,487 @@ void freeQueue(Queue* queue) {
     }
 }
 
+/**
+ * Number of set bits in a word
+ */
+static int wordPopcount(uint64_t word) {
+#if defined(_MSC_VER)
+    int bits = 0;
+    for (; word; word &= word - 1) {
+        bits++;
+    }
+    return bits;
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+/**
+ * Index of the lowest set bit of a non-zero word
+ */
+static int wordLowestBit(uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanForward(&index, (unsigned long)word)) {
+        return (int)index;
+    }
+    _BitScanForward(&index, (unsigned long)(word >> 32));
+    return (int)index + 32;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+/**
+ * Allocates an empty bitset without reporting errors
+ * Returns NULL if numBits is negative or memory allocation fails
+ */
+static Bitset* allocBitset(int numBits) {
+    if (numBits < 0) {
+        return NULL;
+    }
+    Bitset* set = (Bitset*)malloc(sizeof(Bitset));
+    if (!set) {
+        return NULL;
+    }
+    set->numBits = numBits;
+    set->numWords = (int)(((long long)numBits + 63) / 64);
+    set->words = (uint64_t*)calloc(set->numWords ? set->numWords : 1, sizeof(uint64_t));
+    if (!set->words) {
+        free(set);
+        return NULL;
+    }
+    return set;
+}
+
+/**
+ * Creates an empty set of vertices 0 .. numBits - 1
+ * Uses numBits / 8 bytes, an eighth of a bool array
+ */
+Bitset* createBitset(int numBits) {
+    Bitset* set = allocBitset(numBits);
+    if (!set) {
+        printf("Error: Memory allocation failed for bitset\n");
+        return NULL;
+    }
+    return set;
+}
+
+/**
+ * Checks if a bit is set
+ */
+bool bitsetTest(const Bitset* set, int bit) {
+    return (set->words[bit >> 6] >> (bit & 63)) & 1;
+}
+
+/**
+ * Sets a bit
+ * Returns true if the bit was not set before
+ */
+bool bitsetSet(Bitset* set, int bit) {
+    uint64_t* word = &set->words[bit >> 6];
+    uint64_t mask = (uint64_t)1 << (bit & 63);
+    if (*word & mask) {
+        return false;
+    }
+    *word |= mask;
+    return true;
+}
+
+/**
+ * Clears a bit
+ */
+void bitsetClear(Bitset* set, int bit) {
+    set->words[bit >> 6] &= ~((uint64_t)1 << (bit & 63));
+}
+
+/**
+ * Clears every bit, one word at a time
+ */
+void bitsetClearAll(Bitset* set) {
+    memset(set->words, 0, set->numWords * sizeof(uint64_t));
+}
+
+/**
+ * Counts the set bits
+ */
+int bitsetCount(const Bitset* set) {
+    int count = 0;
+    for (int w = 0; w < set->numWords; w++) {
+        count += wordPopcount(set->words[w]);
+    }
+    return count;
+}
+
+/**
+ * Finds the first set bit at or after from, skipping empty words
+ * Returns -1 if there is none
+ */
+int bitsetNext(const Bitset* set, int from) {
+    if (from < 0) {
+        from = 0;
+    }
+    if (from >= set->numBits) {
+        return -1;
+    }
+    int w = from >> 6;
+    uint64_t word = set->words[w] & (~(uint64_t)0 << (from & 63));
+    while (!word) {
+        if (++w == set->numWords) {
+            return -1;
+        }
+        word = set->words[w];
+    }
+    return (w << 6) + wordLowestBit(word);
+}
+
+/**
+ * Adds every bit of src to dest (dest |= src), one word at a time
+ * Returns 0 on success, -1 if the sets differ in size
+ */
+int bitsetOr(Bitset* dest, const Bitset* src) {
+    if (dest->numBits != src->numBits) {
+        return -1;
+    }
+    for (int w = 0; w < dest->numWords; w++) {
+        dest->words[w] |= src->words[w];
+    }
+    return 0;
+}
+
+/**
+ * Removes every bit of src from dest (dest &= ~src), e.g. to drop
+ * visited vertices from a frontier
+ * Returns 0 on success, -1 if the sets differ in size
+ */
+int bitsetAndNot(Bitset* dest, const Bitset* src) {
+    if (dest->numBits != src->numBits) {
+        return -1;
+    }
+    for (int w = 0; w < dest->numWords; w++) {
+        dest->words[w] &= ~src->words[w];
+    }
+    return 0;
+}
+
+/**
+ * Frees memory allocated for the bitset
+ */
+void freeBitset(Bitset* set) {
+    if (set) {
+        free(set->words);
+        free(set);
+    }
+}
+
+/**
+ * Allocates an indexed min-heap without reporting errors
+ * Returns NULL if memory allocation fails
+ */
+static MinHeap* allocMinHeap(int capacity, int arity, int* keys) {
+    MinHeap* heap = (MinHeap*)malloc(sizeof(MinHeap));
+    if (!heap) {
+        return NULL;
+    }
+
+    heap->vertices = (int*)malloc(capacity * sizeof(int));
+    heap->position = (int*)malloc(capacity * sizeof(int));
+    if (!heap->vertices || !heap->position) {
+        free(heap->vertices);
+        free(heap->position);
+        free(heap);
+        return NULL;
+    }
+
+    for (int i = 0; i < capacity; i++) {
+        heap->position[i] = -1;
+    }
+    heap->keys = keys;
+    heap->size = 0;
+    heap->capacity = capacity;
+    heap->arity = arity;
+    return heap;
+}
+
+/**
+ * Creates an indexed min-heap able to hold vertices 0..capacity-1
+ * Priorities are read from the caller-owned keys array (e.g. dist[])
+ */
+MinHeap* createMinHeap(int capacity, int arity, int* keys) {
+    if (arity < 2) {
+        printf("Error: Heap arity must be at least 2\n");
+        return NULL;
+    }
+
+    MinHeap* heap = allocMinHeap(capacity, arity, keys);
+    if (!heap) {
+        printf("Error: Memory allocation failed for heap\n");
+        return NULL;
+    }
+    return heap;
+}
+
+/**
+ * Checks if the heap is empty
+ */
+bool heapIsEmpty(MinHeap* heap) {
+    return heap->size == 0;
+}
+
+/**
+ * Moves the vertex at index i towards the root until the heap order holds
+ */
+static void heapSiftUp(MinHeap* heap, int i) {
+    int vertex = heap->vertices[i];
+    int key = heap->keys[vertex];
+
+    while (i > 0) {
+        int parent = (i - 1) / heap->arity;
+        int parentVertex = heap->vertices[parent];
+        if (heap->keys[parentVertex] <= key) {
+            break;
+        }
+        heap->vertices[i] = parentVertex;
+        heap->position[parentVertex] = i;
+        i = parent;
+    }
+    heap->vertices[i] = vertex;
+    heap->position[vertex] = i;
+}
+
+/**
+ * Moves the vertex at index i towards the leaves until the heap order holds
+ */
+static void heapSiftDown(MinHeap* heap, int i) {
+    int vertex = heap->vertices[i];
+    int key = heap->keys[vertex];
+
+    for (;;) {
+        int first = i * heap->arity + 1;
+        if (first >= heap->size) {
+            break;
+        }
+
+        // Pick the smallest of the (up to arity) children
+        int last = first + heap->arity;
+        if (last > heap->size) {
+            last = heap->size;
+        }
+        int best = first;
+        for (int c = first + 1; c < last; c++) {
+            if (heap->keys[heap->vertices[c]] < heap->keys[heap->vertices[best]]) {
+                best = c;
+            }
+        }
+
+        int bestVertex = heap->vertices[best];
+        if (heap->keys[bestVertex] >= key) {
+            break;
+        }
+        heap->vertices[i] = bestVertex;
+        heap->position[bestVertex] = i;
+        i = best;
+    }
+    heap->vertices[i] = vertex;
+    heap->position[vertex] = i;
+}
+
+/**
+ * Lowers the priority of a vertex to key
+ * Inserts the vertex if it is not currently in the heap
+ */
+void heapDecreaseKey(MinHeap* heap, int vertex, int key) {
+    heap->keys[vertex] = key;
+
+    int i = heap->position[vertex];
+    if (i == -1) {
+        i = heap->size++;
+        heap->vertices[i] = vertex;
+    }
+    heapSiftUp(heap, i);
+}
+
+/**
+ * Removes and returns the vertex with the smallest key
+ * Returns -1 if heap is empty
+ */
+int heapExtractMin(MinHeap* heap) {
+    if (heapIsEmpty(heap)) {
+        return -1;
+    }
+
+    int root = heap->vertices[0];
+    heap->position[root] = -1;
+    heap->size--;
+
+    if (heap->size > 0) {
+        heap->vertices[0] = heap->vertices[heap->size];
+        heapSiftDown(heap, 0);
+    }
+    return root;
+}
+
+/**
+ * Frees memory allocated for the heap
+ * The keys array is owned by the caller and is not freed
+ */
+void freeMinHeap(MinHeap* heap) {
+    if (heap) {
+        free(heap->vertices);
+        free(heap->position);
+        free(heap);
+    }
+}
+
+/**
+ * Allocates a traversal context without reporting errors
+ * Returns NULL if vertices is not positive or memory allocation fails
+ */
+static TraversalContext* allocTraversalContext(int vertices) {
+    if (vertices <= 0) {
+        return NULL;
+    }
+
+    TraversalContext* ctx = (TraversalContext*)malloc(sizeof(TraversalContext));
+    if (!ctx) {
+        return NULL;
+    }
+
+    ctx->numVertices = vertices;
+    ctx->visited = allocBitset(vertices);
+    ctx->touchedWords = ctx->visited ? (int*)malloc(ctx->visited->numWords * sizeof(int)) : NULL;
+    ctx->numTouched = 0;
+    ctx->order = (int*)malloc(vertices * sizeof(int));
+    ctx->stack = (int*)malloc(vertices * sizeof(int));
+    ctx->cursor = (int*)malloc(vertices * sizeof(int));
+    ctx->edge = (Node**)malloc(vertices * sizeof(Node*));
+    ctx->queue = allocQueue(vertices);
+    if (!ctx->visited || !ctx->touchedWords || !ctx->order || !ctx->stack || !ctx->cursor || !ctx->edge ||
+        !ctx->queue) {
+        freeTraversalContext(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+/**
+ * Creates a reusable traversal context for graphs with up to the given
+ * number of vertices
+ * Each thread traversing a shared graph should own its own context
+ */
+TraversalContext* createTraversalContext(int vertices) {
+    if (vertices <= 0) {
+        printf("Error: Number of vertices must be positive\n");
+        return NULL;
+    }
+
+    TraversalContext* ctx = allocTraversalContext(vertices);
+    if (!ctx) {
+        printf("Error: Memory allocation failed for traversal context\n");
+        return NULL;
+    }
+    return ctx;
+}
+
+/**
+ * Marks every vertex as unvisited
+ * Clears only the words the last traversal touched, so the cost follows
+ * that traversal's size rather than numVertices
+ */
+void resetTraversalContext(TraversalContext* ctx) {
+    if (ctx->numTouched == ctx->visited->numWords) {
+        // Every word, or the list filled up: a full clear is no dearer
+        bitsetClearAll(ctx->visited);
+    } else {
+        for (int i = 0; i < ctx->numTouched; i++) {
+            ctx->visited->words[ctx->touchedWords[i]] = 0;
+        }
+    }
+    ctx->numTouched = 0;
+}
+
+/**
+ * Checks if a vertex has been visited in the current traversal
+ */
+bool isVisited(TraversalContext* ctx, int vertex) {
+    return bitsetTest(ctx->visited, vertex);
+}
+
+/**
+ * Marks a vertex as visited in the current traversal
+ * Returns true if the vertex was not visited before
+ */
+bool markVisited(TraversalContext* ctx, int vertex) {
+    if (!bitsetSet(ctx->visited, vertex)) {
+        return false;
+    }
+    // First bit in its word since the reset: remember the word for the next one
+    int word = vertex >> 6;
+    if (ctx->visited->words[word] == (uint64_t)1 << (vertex & 63) &&
+        ctx->numTouched < ctx->visited->numWords) {
+        ctx->touchedWords[ctx->numTouched++] = word;
+    }
+    return true;
+}
+
+/**
+ * Frees memory allocated for the traversal context
+ */
+void freeTraversalContext(TraversalContext* ctx) {
+    if (ctx) {
+        freeBitset(ctx->visited);
+        free(ctx->touchedWords);
+        free(ctx->order);
+        free(ctx->stack);
+        free(ctx->cursor);
+        free(ctx->edge);
+        freeQueue(ctx->queue);
+        free(ctx);
+    }
+}
+
+/**
+ * Checks that a context is large enough for a graph
+ */
+static bool contextFits(TraversalContext* ctx, int numVertices) {
+    return ctx && ctx->numVertices >= numVertices;
+}
+
+/**
+ * Checks that a context is large enough for a graph, reporting why not
+ */
+static bool checkContext(TraversalContext* ctx, int numVertices) {
+    if (!ctx) {
+        printf("Error: Traversal context is NULL\n");
+        return false;
+    }
+    if (!contextFits(ctx, numVertices)) {
+        printf("Error: Traversal context holds %d vertices, graph has %d\n",
+               ctx->numVertices, numVertices);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Prints the visit order recorded by a traversal
+ */
+static void printTraversal(const char* name, int startVertex, const int* order, int count) {
+    printf("\n=== %s Traversal starting from vertex %d ===\n", name, startVertex);
+    printf("Visit order: ");
+    for (int i = 0; i < count; i++) {
+        printf("%d ", order[i]);
+    }
+    printf("\n=======================================\n\n");
+}
+
 /* ====================
  * CORE GRAPH FUNCTIONS
  * ==================== */
 
 /**
  * Creates a new graph with the specified number of vertices
- * Initializes adjacency lists and visited array
+ * Initializes adjacency lists and visited set
  */
 Graph* createGraph(int vertices) {
     // Validate input
@@ -138,8 +651,8 @@ Graph* createGraph(int vertices) {
         return NULL;
     }
     
-    // Allocate memory for visited array
-    graph->visited = (bool*)malloc(vertices * sizeof(bool));
+    // Allocate memory for visited set
+    graph->visited = allocBitset(vertices);
     if (!graph->visited) {
         printf("Error: Memory allocation failed for visited array\n");
         free(graph->adjLists);
@@ -147,10 +660,19 @@ Graph* createGraph(int vertices) {
         return NULL;
     }
     
-    // Initialize all adjacency lists as NULL and visited as false
+    // Adjacency nodes are carved from slabs so they sit close together
+    graph->nodePool = createNodePool(sizeof(Node), 0);
+    if (!graph->nodePool) {
+        printf("Error: Memory allocation failed for adjacency node pool\n");
+        freeBitset(graph->visited);
+        free(graph->adjLists);
+        free(graph);
+        return NULL;
+    }
+    
+    // Initialize all adjacency lists as NULL
     for (int i = 0; i < vertices; i++) {
         graph->adjLists[i] = NULL;
-        graph->visited[i] = false;
     }
     
     printf("Graph created successfully with %d vertices\n", vertices);
@@ -174,10 +696,10 @@ void addEdge(Graph* graph, int src, int dest, int weight) {
         return;
     }
     
-    // Create new node for destination vertex
-    Node* newNode = createNode(dest, weight);
+    // Create new node for destination vertex from the graph's pool
+    Node* newNode = createNode(graph, dest, weight);
     if (!newNode) {
-        return;  // Error message already printed in createNode
+        return;
     }
     
     // Add the new node at the beginning of the adjacency list
@@ -217,7 +739,11 @@ void removeEdge(Graph* graph, int src, int dest) {
                 // Removing a node in the middle or end
                 prev->next = current->next;
             }
-            free(current);
+            if (graph->nodePool) {
+                poolFree(graph->nodePool, current);
+            } else {
+                free(current);
+            }
             printf("Edge removed: %d -> %d\n", src, dest);
             return;
         }
@@ -228,6 +754,32 @@ void removeEdge(Graph* graph, int src, int dest) {
     printf("Edge not found: %d -> %d\n", src, dest);
 }
 
+/**
+ * Removes every edge of the graph in O(V) without freeing it
+ * Pooled nodes are released with a single pool reset
+ */
+void clearGraph(Graph* graph) {
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return;
+    }
+    
+    if (graph->nodePool) {
+        poolReset(graph->nodePool);
+    }
+    for (int v = 0; v < graph->numVertices; v++) {
+        if (!graph->nodePool) {
+            Node* current = graph->adjLists[v];
+            while (current) {
+                Node* temp = current;
+                current = current->next;
+                free(temp);
+            }
+        }
+        graph->adjLists[v] = NULL;
+    }
+}
+
 /**
  * Displays the adjacency list representation of the graph
  * Shows all vertices and their connections with weights
@@ -262,25 +814,31 @@ void displayGraph(Graph* graph) {
 /**
  * Frees all memory allocated for the graph
  * Properly deallocates adjacency lists, visited array, and graph structure
+ * Pooled adjacency nodes are released together with their slabs
  */
 void freeGraph(Graph* graph) {
     if (!graph) {
         return;
     }
     
-    // Free all nodes in adjacency lists
-    for (int v = 0; v < graph->numVertices; v++) {
-        Node* current = graph->adjLists[v];
-        while (current) {
-            Node* temp = current;
-            current = current->next;
-            free(temp);
+    if (graph->nodePool) {
+        // Every node lives in the pool, so no list walk is needed
+        freeNodePool(graph->nodePool);
+    } else {
+        // Free all nodes in adjacency lists
+        for (int v = 0; v < graph->numVertices; v++) {
+            Node* current = graph->adjLists[v];
+            while (current) {
+                Node* temp = current;
+                current = current->next;
+                free(temp);
+            }
         }
     }
     
     // Free the arrays and graph structure
     free(graph->adjLists);
-    free(graph->visited);
+    freeBitset(graph->visited);
     free(graph);
     
     printf("Graph memory freed successfully\n");
@@ -291,44 +849,34 @@ void freeGraph(Graph* graph) {
  * ======================== */
 
 /**
- * Performs Breadth-First Search starting from a given vertex
- * Uses a queue to visit vertices level by level
+ * BFS core shared by the printing and result-returning variants
+ * Writes the visit order and, when non-NULL, the level and parent of
+ * every vertex (-1 if unreached); returns the number of vertices visited
  */
-void bfs(Graph* graph, int startVertex) {
-    // Validate input parameters
-    if (!graph) {
-        printf("Error: Graph is NULL\n");
-        return;
-    }
-    
-    if (startVertex < 0 || startVertex >= graph->numVertices) {
-        printf("Error: Invalid start vertex. Must be between 0 and %d\n", graph->numVertices - 1);
-        return;
-    }
-    
-    // Reset visited array for fresh traversal
-    for (int i = 0; i < graph->numVertices; i++) {
-        graph->visited[i] = false;
-    }
-    
-    // Create queue for BFS
-    Queue* queue = createQueue(graph->numVertices);
-    if (!queue) {
-        return;
+static int bfsCollect(Graph* graph, int startVertex, TraversalContext* ctx,
+                      int* order, int* level, int* parent) {
+    if (level || parent) {
+        for (int i = 0; i < graph->numVertices; i++) {
+            if (level) level[i] = -1;
+            if (parent) parent[i] = -1;
+        }
+        if (level) level[startVertex] = 0;
     }
     
-    printf("\n=== BFS Traversal starting from vertex %d ===\n", startVertex);
-    printf("Visit order: ");
+    // Start a fresh traversal; clears only the words the last one touched
+    resetTraversalContext(ctx);
+    Queue* queue = ctx->queue;
+    int count = 0;
     
     // Mark start vertex as visited and enqueue it
-    graph->visited[startVertex] = true;
+    markVisited(ctx, startVertex);
     enqueue(queue, startVertex);
     
     // Continue until queue is empty
     while (!isEmpty(queue)) {
-        // Dequeue a vertex and print it
         int currentVertex = dequeue(queue);
-        printf("%d ", currentVertex);
+        if (order) order[count] = currentVertex;
+        count++;
         
         // Get all adjacent vertices of the dequeued vertex
         Node* temp = graph->adjLists[currentVertex];
@@ -336,41 +884,208 @@ void bfs(Graph* graph, int startVertex) {
             int adjVertex = temp->vertex;
             
             // If adjacent vertex hasn't been visited, mark it and enqueue
-            if (!graph->visited[adjVertex]) {
-                graph->visited[adjVertex] = true;
+            if (markVisited(ctx, adjVertex)) {
+                if (level) level[adjVertex] = level[currentVertex] + 1;
+                if (parent) parent[adjVertex] = currentVertex;
                 enqueue(queue, adjVertex);
             }
             temp = temp->next;
         }
     }
+    return count;
+}
+
+/**
+ * Performs Breadth-First Search starting from a given vertex
+ * Uses a temporary traversal context, so the graph itself is not modified
+ */
+void bfs(Graph* graph, int startVertex) {
+    // Validate input parameters
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return;
+    }
     
-    printf("\n=======================================\n\n");
-    freeQueue(queue);
+    TraversalContext* ctx = createTraversalContext(graph->numVertices);
+    if (!ctx) {
+        return;
+    }
+    bfsWithContext(graph, startVertex, ctx);
+    freeTraversalContext(ctx);
+}
+
+/**
+ * Performs Breadth-First Search using the caller's traversal context
+ * Uses the context's queue to visit vertices level by level
+ */
+void bfsWithContext(Graph* graph, int startVertex, TraversalContext* ctx) {
+    // Validate input parameters
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return;
+    }
+    
+    if (startVertex < 0 || startVertex >= graph->numVertices) {
+        printf("Error: Invalid start vertex. Must be between 0 and %d\n", graph->numVertices - 1);
+        return;
+    }
+    
+    if (!checkContext(ctx, graph->numVertices)) {
+        return;
+    }
+    
+    int count = bfsCollect(graph, startVertex, ctx, ctx->order, NULL, NULL);
+    printTraversal("BFS", startVertex, ctx->order, count);
+}
+
+/**
+ * Breadth-First Search that writes its results instead of printing
+ * order, level and parent are optional caller buffers of numVertices ints;
+ * ctx may be NULL to use a temporary context
+ * Returns the number of vertices visited, or -1 on invalid input
+ */
+int bfsInto(Graph* graph, int startVertex, TraversalContext* ctx,
+            int* order, int* level, int* parent) {
+    if (!graph || startVertex < 0 || startVertex >= graph->numVertices) {
+        return -1;
+    }
+    if (ctx) {
+        return contextFits(ctx, graph->numVertices)
+            ? bfsCollect(graph, startVertex, ctx, order, level, parent) : -1;
+    }
+    
+    TraversalContext* temp = allocTraversalContext(graph->numVertices);
+    if (!temp) {
+        return -1;
+    }
+    int count = bfsCollect(graph, startVertex, temp, order, level, parent);
+    freeTraversalContext(temp);
+    return count;
 }
 
 /**
- * Helper function for recursive DFS implementation
- * Visits the current vertex and recursively visits all unvisited adjacent vertices
+ * Helper function for DFS that prints vertices as they are visited
+ * Keeps an explicit stack of vertices and their next adjacency node, so
+ * long paths cannot overflow the C stack
+ * Uses graph->visited, which the caller must reset; prefer dfsWithContext()
  */
 void dfsUtil(Graph* graph, int vertex) {
-    // Mark current vertex as visited and print it
-    graph->visited[vertex] = true;
+    int* stack = (int*)malloc(graph->numVertices * sizeof(int));
+    Node** edge = (Node**)malloc(graph->numVertices * sizeof(Node*));
+    if (!stack || !edge) {
+        printf("Error: Memory allocation failed for DFS stack\n");
+        free(stack);
+        free(edge);
+        return;
+    }
+
+    // Mark the start vertex as visited and print it
+    bitsetSet(graph->visited, vertex);
     printf("%d ", vertex);
+    int top = 0;
+    stack[0] = vertex;
+    edge[0] = graph->adjLists[vertex];
+
+    while (top >= 0) {
+        Node* temp = edge[top];
+        if (!temp) {
+            top--;  // All adjacent vertices explored, backtrack
+            continue;
+        }
+        edge[top] = temp->next;
+
+        // Descend into the first unvisited adjacent vertex
+        int adjVertex = temp->vertex;
+        if (bitsetSet(graph->visited, adjVertex)) {
+            printf("%d ", adjVertex);
+            top++;
+            stack[top] = adjVertex;
+            edge[top] = graph->adjLists[adjVertex];
+        }
+    }
+    free(stack);
+    free(edge);
+}
+
+/**
+ * DFS core shared by the printing, result-returning and callback variants
+ * Keeps an explicit stack of vertices and their next adjacency node, and
+ * visits vertices in the same order as the recursive dfsUtil() would
+ * Returns the number of vertices visited
+ */
+static int dfsCollect(Graph* graph, int startVertex, TraversalContext* ctx,
+                      int* order, int* parent,
+                      DfsCallback preorder, DfsCallback postorder, void* arg) {
+    if (parent) {
+        for (int i = 0; i < graph->numVertices; i++) {
+            parent[i] = -1;
+        }
+    }
     
-    // Recursively visit all unvisited adjacent vertices
-    Node* temp = graph->adjLists[vertex];
-    while (temp) {
+    // Start a fresh traversal; clears only the words the last one touched
+    resetTraversalContext(ctx);
+    int* stack = ctx->stack;
+    Node** edge = ctx->edge;
+    int count = 0;
+
+    int top = 0;
+    stack[0] = startVertex;
+    edge[0] = graph->adjLists[startVertex];
+    markVisited(ctx, startVertex);
+    if (order) order[count] = startVertex;
+    count++;
+    if (preorder) preorder(startVertex, -1, arg);
+
+    while (top >= 0) {
+        int vertex = stack[top];
+        Node* temp = edge[top];
+        if (!temp) {
+            top--;  // All edges explored, backtrack
+            if (postorder) postorder(vertex, top >= 0 ? stack[top] : -1, arg);
+            continue;
+        }
+        edge[top] = temp->next;
+
         int adjVertex = temp->vertex;
-        if (!graph->visited[adjVertex]) {
-            dfsUtil(graph, adjVertex);
+        if (markVisited(ctx, adjVertex)) {
+            if (order) order[count] = adjVertex;
+            if (parent) parent[adjVertex] = vertex;
+            count++;
+            top++;
+            stack[top] = adjVertex;
+            edge[top] = graph->adjLists[adjVertex];
+            if (preorder) preorder(adjVertex, vertex, arg);
         }
-        temp = temp->next;
     }
+    return count;
+}
+
+/**
+ * Validates the input and runs dfsCollect(), in a temporary context
+ * when ctx is NULL; returns -1 on invalid input
+ */
+static int dfsRun(Graph* graph, int startVertex, TraversalContext* ctx, int* order, int* parent,
+                  DfsCallback preorder, DfsCallback postorder, void* arg) {
+    if (!graph || startVertex < 0 || startVertex >= graph->numVertices) {
+        return -1;
+    }
+    if (ctx) {
+        return contextFits(ctx, graph->numVertices)
+            ? dfsCollect(graph, startVertex, ctx, order, parent, preorder, postorder, arg) : -1;
+    }
+    
+    TraversalContext* temp = allocTraversalContext(graph->numVertices);
+    if (!temp) {
+        return -1;
+    }
+    int count = dfsCollect(graph, startVertex, temp, order, parent, preorder, postorder, arg);
+    freeTraversalContext(temp);
+    return count;
 }
 
 /**
  * Performs Depth-First Search starting from a given vertex
- * Uses recursion to visit vertices in depth-first manner
+ * Uses a temporary traversal context, so the graph itself is not modified
  */
 void dfs(Graph* graph, int startVertex) {
     // Validate input parameters
@@ -379,23 +1094,58 @@ void dfs(Graph* graph, int startVertex) {
         return;
     }
     
+    TraversalContext* ctx = createTraversalContext(graph->numVertices);
+    if (!ctx) {
+        return;
+    }
+    dfsWithContext(graph, startVertex, ctx);
+    freeTraversalContext(ctx);
+}
+
+/**
+ * Performs Depth-First Search using the caller's traversal context
+ * Runs in constant C stack space, see dfsCollect()
+ */
+void dfsWithContext(Graph* graph, int startVertex, TraversalContext* ctx) {
+    // Validate input parameters
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return;
+    }
+    
     if (startVertex < 0 || startVertex >= graph->numVertices) {
         printf("Error: Invalid start vertex. Must be between 0 and %d\n", graph->numVertices - 1);
         return;
     }
     
-    // Reset visited array for fresh traversal
-    for (int i = 0; i < graph->numVertices; i++) {
-        graph->visited[i] = false;
+    if (!checkContext(ctx, graph->numVertices)) {
+        return;
     }
     
-    printf("\n=== DFS Traversal starting from vertex %d ===\n", startVertex);
-    printf("Visit order: ");
-    
-    // Start DFS from the given vertex
-    dfsUtil(graph, startVertex);
-    
-    printf("\n=======================================\n\n");
+    int count = dfsCollect(graph, startVertex, ctx, ctx->order, NULL, NULL, NULL, NULL);
+    printTraversal("DFS", startVertex, ctx->order, count);
+}
+
+/**
+ * Depth-First Search that writes its results instead of printing
+ * order and parent are optional caller buffers of numVertices ints;
+ * ctx may be NULL to use a temporary context
+ * Returns the number of vertices visited, or -1 on invalid input
+ */
+int dfsInto(Graph* graph, int startVertex, TraversalContext* ctx, int* order, int* parent) {
+    return dfsRun(graph, startVertex, ctx, order, parent, NULL, NULL, NULL);
+}
+
+/**
+ * Depth-First Search that reports each vertex to the caller
+ * preorder runs when a vertex is first reached and postorder once all
+ * of its edges are explored; either may be NULL, and ctx may be NULL
+ * to use a temporary context
+ * Returns the number of vertices visited, or -1 on invalid input
+ */
+int dfsWithCallbacks(Graph* graph, int startVertex, TraversalContext* ctx,
+                     DfsCallback preorder, DfsCallback postorder, void* arg) {
+    return dfsRun(graph, startVertex, ctx, NULL, NULL, preorder, postorder, arg);
 }
 
 /* ========================
@@ -403,8 +1153,8 @@ void dfs(Graph* graph, int startVertex) {
  * ======================== */
 
 /**
- * Finds the vertex with minimum distance value
- * Used by Dijkstra's algorithm to find the next vertex to process
+ * Finds the unvisited vertex with minimum distance value
+ * Kept for callers with a bool array; Dijkstra itself uses a bitset
  */
 int minDistance(int dist[], bool visited[], int vertices) {
     int min = INT_MAX;
@@ -419,44 +1169,48 @@ int minDistance(int dist[], bool visited[], int vertices) {
     
     return minIndex;
 }
-/*Implements Dijkstra's shortest path algorithm*/
-void dijkstra(Graph* graph, int startVertex) {
-    // Validate input parameters
-    if (!graph) {
-        printf("Error: Graph is NULL\n");
-        return;
-    }
-    if (startVertex < 0 || startVertex >= graph->numVertices) {
-        printf("Error: Invalid start vertex. Must be between 0 and %d\n", graph->numVertices - 1);
-        return;
+/**
+ * minDistance() over a visited bitset: walks the clear bits one word at
+ * a time, so settled runs of 64 vertices are skipped in a single step
+ */
+static int minUnvisitedDistance(const int* dist, const Bitset* visited) {
+    int min = INT_MAX;
+    int minIndex = -1;
+
+    for (int w = 0; w < visited->numWords; w++) {
+        uint64_t unvisited = ~visited->words[w];
+        if (w == visited->numWords - 1 && (visited->numBits & 63)) {
+            unvisited &= ((uint64_t)1 << (visited->numBits & 63)) - 1;
+        }
+        while (unvisited) {
+            int v = (w << 6) + wordLowestBit(unvisited);
+            unvisited &= unvisited - 1;
+            if (dist[v] <= min) {
+                min = dist[v];
+                minIndex = v;
+            }
+        }
     }
+
+    return minIndex;
+}
+
+/**
+ * Dense Dijkstra: picks the next vertex with a linear scan over dist[]
+ * O(V^2) overall, which beats a heap only when E is close to V^2
+ */
+static void dijkstraDense(Graph* graph, int* dist, int* pred, Bitset* visited) {
     int numVertices = graph->numVertices;
-    // Arrays to store shortest distances and visited status
-    int* dist = (int*)malloc(numVertices * sizeof(int));
-    bool* visited = (bool*)malloc(numVertices * sizeof(bool));
-    if (!dist || !visited) {
-        printf("Error: Memory allocation failed for Dijkstra's algorithm\n");
-        free(dist);
-        free(visited);
-        return;
-    }
-    // Initialize distances as infinite and visited as false
-    for (int i = 0; i < numVertices; i++) {
-        dist[i] = INT_MAX;
-        visited[i] = false;
-    }
-    // Distance from source to itself is 0
-    dist[startVertex] = 0;
-    printf("\n=== Dijkstra's Shortest Path from vertex %d ===\n", startVertex);
+
     // Find shortest path for all vertices
     for (int count = 0; count < numVertices - 1; count++) {
         // Pick the minimum distance vertex not yet processed
-        int u = minDistance(dist, visited, numVertices);
+        int u = minUnvisitedDistance(dist, visited);
         
         if (u == -1) break;  // All remaining vertices are inaccessible
         
         // Mark the picked vertex as processed
-        visited[u] = true;
+        bitsetSet(visited, u);
         Node* temp = graph->adjLists[u];
         while (temp) {
             int v = temp->vertex;
@@ -464,13 +1218,213 @@ void dijkstra(Graph* graph, int startVertex) {
             
             // Update dist[v] if not visited, there's an edge from u to v,
             // and total weight of path from start to v through u is smaller
-            if (!visited[v] && dist[u] != INT_MAX && 
+            if (!bitsetTest(visited, v) && dist[u] != INT_MAX && 
                 dist[u] + weight < dist[v]) {
                 dist[v] = dist[u] + weight;
+                if (pred) pred[v] = u;
+            }
+            temp = temp->next;
+        }
+    }
+}
+
+/**
+ * Heap Dijkstra: keeps every reached vertex once in an indexed heap
+ * and lowers its key in place, O((V + E) log V)
+ * Returns false if the heap could not be allocated
+ */
+static bool dijkstraIndexedHeap(Graph* graph, int startVertex, int arity,
+                                int* dist, int* pred, Bitset* visited) {
+    MinHeap* heap = allocMinHeap(graph->numVertices, arity, dist);
+    if (!heap) {
+        return false;
+    }
+
+    heapDecreaseKey(heap, startVertex, 0);
+    while (!heapIsEmpty(heap)) {
+        int u = heapExtractMin(heap);
+        bitsetSet(visited, u);
+
+        Node* temp = graph->adjLists[u];
+        while (temp) {
+            int v = temp->vertex;
+            if (!bitsetTest(visited, v) && dist[u] + temp->weight < dist[v]) {
+                heapDecreaseKey(heap, v, dist[u] + temp->weight);
+                if (pred) pred[v] = u;
+            }
+            temp = temp->next;
+        }
+    }
+
+    freeMinHeap(heap);
+    return true;
+}
+
+/*Entry of the lazy-deletion heap: a vertex and the distance it was pushed with*/
+typedef struct HeapEntry {
+    int dist;
+    int vertex;
+} HeapEntry;
+
+/*Growable binary heap of HeapEntry, ordered by dist*/
+typedef struct LazyHeap {
+    HeapEntry* entries;
+    int size;
+    int capacity;
+} LazyHeap;
+
+/**
+ * Pushes a (dist, vertex) entry, growing the array when it is full
+ * Returns false if the array could not be grown
+ */
+static bool lazyHeapPush(LazyHeap* heap, int dist, int vertex) {
+    if (heap->size == heap->capacity) {
+        int capacity = heap->capacity ? 2 * heap->capacity : 16;
+        HeapEntry* grown = (HeapEntry*)realloc(heap->entries, capacity * sizeof(HeapEntry));
+        if (!grown) {
+            return false;
+        }
+        heap->entries = grown;
+        heap->capacity = capacity;
+    }
+
+    int j = heap->size++;
+    while (j > 0 && heap->entries[(j - 1) / 2].dist > dist) {
+        heap->entries[j] = heap->entries[(j - 1) / 2];
+        j = (j - 1) / 2;
+    }
+    heap->entries[j] = (HeapEntry){dist, vertex};
+    return true;
+}
+
+/**
+ * Removes and returns the entry with the smallest dist
+ * Caller must make sure the heap is not empty
+ */
+static HeapEntry lazyHeapPop(LazyHeap* heap) {
+    HeapEntry* entries = heap->entries;
+    HeapEntry top = entries[0];
+    HeapEntry last = entries[--heap->size];
+    int size = heap->size;
+    int i = 0;
+
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= size) break;
+        if (child + 1 < size && entries[child + 1].dist < entries[child].dist) {
+            child++;
+        }
+        if (entries[child].dist >= last.dist) break;
+        entries[i] = entries[child];
+        i = child;
+    }
+    if (size > 0) {
+        entries[i] = last;
+    }
+    return top;
+}
+
+/**
+ * Lazy Dijkstra: pushes a new (dist, vertex) entry on every relaxation
+ * and skips entries that are stale when popped, O((V + E) log E)
+ * Returns false if the heap could not be allocated
+ */
+static bool dijkstraLazyHeap(Graph* graph, int startVertex, int* dist, int* pred, Bitset* visited) {
+    LazyHeap heap = {NULL, 0, 0};
+    bool ok = lazyHeapPush(&heap, 0, startVertex);
+
+    while (ok && heap.size > 0) {
+        HeapEntry top = lazyHeapPop(&heap);
+        int u = top.vertex;
+        if (bitsetTest(visited, u) || top.dist > dist[u]) {
+            continue;  // Stale entry, vertex was already settled
+        }
+        bitsetSet(visited, u);
+
+        Node* temp = graph->adjLists[u];
+        while (ok && temp) {
+            int v = temp->vertex;
+            int newDist = dist[u] + temp->weight;
+            if (!bitsetTest(visited, v) && newDist < dist[v]) {
+                dist[v] = newDist;
+                if (pred) pred[v] = u;
+                ok = lazyHeapPush(&heap, newDist, v);
             }
             temp = temp->next;
         }
     }
+
+    free(heap.entries);
+    return ok;
+}
+
+/**
+ * Runs the selected Dijkstra strategy over the adjacency lists
+ * Returns false if the priority queue could not be allocated
+ */
+static bool dijkstraSolve(Graph* graph, int startVertex, DijkstraMode mode,
+                          int* dist, int* pred, Bitset* visited) {
+    switch (mode) {
+        case DIJKSTRA_DENSE:
+            dijkstraDense(graph, dist, pred, visited);
+            return true;
+        case DIJKSTRA_QUAD_HEAP:
+            return dijkstraIndexedHeap(graph, startVertex, 4, dist, pred, visited);
+        case DIJKSTRA_LAZY_HEAP:
+            return dijkstraLazyHeap(graph, startVertex, dist, pred, visited);
+        case DIJKSTRA_BINARY_HEAP:
+        default:
+            return dijkstraIndexedHeap(graph, startVertex, 2, dist, pred, visited);
+    }
+}
+
+static bool csrDijkstraSolve(const CsrGraph* csr, int startVertex, DijkstraMode mode,
+                             int* dist, int* pred, Bitset* visited);
+
+/**
+ * Shared core for every Dijkstra entry point; exactly one of graph and
+ * csr is non-NULL and the start vertex has already been validated
+ * Fills dist (INT_MAX if unreachable) and, when non-NULL, pred (-1 if none)
+ * Returns false if memory allocation fails
+ */
+static bool dijkstraCompute(Graph* graph, const CsrGraph* csr, int numVertices,
+                            int startVertex, DijkstraMode mode, int* dist, int* pred) {
+    Bitset* visited = allocBitset(numVertices);
+    if (!visited) {
+        return false;
+    }
+    // Initialize distances as infinite; the visited set starts empty
+    for (int i = 0; i < numVertices; i++) {
+        dist[i] = INT_MAX;
+        if (pred) pred[i] = -1;
+    }
+    // Distance from source to itself is 0
+    dist[startVertex] = 0;
+    // Find shortest path for all vertices
+    bool ok = graph ? dijkstraSolve(graph, startVertex, mode, dist, pred, visited)
+                    : csrDijkstraSolve(csr, startVertex, mode, dist, pred, visited);
+    freeBitset(visited);
+    return ok;
+}
+
+/**
+ * Shared driver for dijkstraWithMode() and csrDijkstraWithMode()
+ * Exactly one of graph and csr is non-NULL
+ */
+static void dijkstraRun(Graph* graph, const CsrGraph* csr, int numVertices,
+                        int startVertex, DijkstraMode mode) {
+    if (startVertex < 0 || startVertex >= numVertices) {
+        printf("Error: Invalid start vertex. Must be between 0 and %d\n", numVertices - 1);
+        return;
+    }
+    // Array to store shortest distances
+    int* dist = (int*)malloc(numVertices * sizeof(int));
+    if (!dist || !dijkstraCompute(graph, csr, numVertices, startVertex, mode, dist, NULL)) {
+        printf("Error: Memory allocation failed for Dijkstra's algorithm\n");
+        free(dist);
+        return;
+    }
+    printf("\n=== Dijkstra's Shortest Path from vertex %d ===\n", startVertex);
     // Print the shortest distances
     printf("Vertex\tDistance from Source\n");
     for (int i = 0; i < numVertices; i++) {
@@ -483,5 +1437,1290 @@ void dijkstra(Graph* graph, int startVertex) {
     printf("==========================================\n\n");
     // Free allocated memory
     free(dist);
-    free(visited);
+}
+
+/*Implements Dijkstra's shortest path algorithm using a binary heap*/
+void dijkstra(Graph* graph, int startVertex) {
+    dijkstraWithMode(graph, startVertex, DIJKSTRA_BINARY_HEAP);
+}
+
+/*Implements Dijkstra's shortest path algorithm with a selectable priority queue*/
+void dijkstraWithMode(Graph* graph, int startVertex, DijkstraMode mode) {
+    // Validate input parameters
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return;
+    }
+    dijkstraRun(graph, NULL, graph->numVertices, startVertex, mode);
+}
+
+/**
+ * Dijkstra's algorithm that writes its results instead of printing
+ * dist must hold numVertices ints (INT_MAX marks unreachable vertices);
+ * pred is optional and receives each vertex's predecessor (-1 if none)
+ * Returns 0 on success, -1 on invalid input or allocation failure
+ */
+int dijkstraInto(Graph* graph, int startVertex, DijkstraMode mode, int* dist, int* pred) {
+    if (!graph || !dist || startVertex < 0 || startVertex >= graph->numVertices) {
+        return -1;
+    }
+    return dijkstraCompute(graph, NULL, graph->numVertices, startVertex, mode, dist, pred) ? 0 : -1;
+}
+
+/* ========================
+ * CSR GRAPH REPRESENTATION
+ * ======================== */
+
+/**
+ * Builds an immutable CSR snapshot of the graph
+ * Edges of each vertex keep their adjacency list order, so traversals
+ * over the snapshot visit vertices in the same order as over the lists
+ */
+CsrGraph* createCsrGraph(Graph* graph) {
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    int numVertices = graph->numVertices;
+    CsrGraph* csr = (CsrGraph*)malloc(sizeof(CsrGraph));
+    if (!csr) {
+        printf("Error: Memory allocation failed for CSR graph\n");
+        return NULL;
+    }
+    csr->numVertices = numVertices;
+    csr->mapping = NULL;
+    csr->mappingSize = 0;
+    csr->offsets = (int*)malloc((numVertices + 1) * sizeof(int));
+    if (!csr->offsets) {
+        printf("Error: Memory allocation failed for CSR offsets\n");
+        free(csr);
+        return NULL;
+    }
+
+    // First pass: out-degree prefix sums give each vertex its edge range
+    int numEdges = 0;
+    for (int v = 0; v < numVertices; v++) {
+        csr->offsets[v] = numEdges;
+        for (Node* temp = graph->adjLists[v]; temp; temp = temp->next) {
+            numEdges++;
+        }
+    }
+    csr->offsets[numVertices] = numEdges;
+    csr->numEdges = numEdges;
+
+    // Always allocate at least one slot so an edgeless graph is still valid
+    csr->targets = (int*)malloc((numEdges ? numEdges : 1) * sizeof(int));
+    csr->weights = (int*)malloc((numEdges ? numEdges : 1) * sizeof(int));
+    if (!csr->targets || !csr->weights) {
+        printf("Error: Memory allocation failed for CSR edge arrays\n");
+        free(csr->targets);
+        free(csr->weights);
+        free(csr->offsets);
+        free(csr);
+        return NULL;
+    }
+
+    // Second pass: copy the edges into their ranges
+    for (int v = 0; v < numVertices; v++) {
+        int e = csr->offsets[v];
+        for (Node* temp = graph->adjLists[v]; temp; temp = temp->next, e++) {
+            csr->targets[e] = temp->vertex;
+            csr->weights[e] = temp->weight;
+        }
+    }
+    return csr;
+}
+
+/**
+ * Builds the transpose of the graph as a CSR snapshot
+ * Edges of vertex v are the sources u of every edge u -> v, in increasing
+ * order of u; used as the incoming-edge index of bottom-up BFS
+ */
+CsrGraph* createTransposeCsrGraph(Graph* graph) {
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    int numVertices = graph->numVertices;
+    CsrGraph* csr = (CsrGraph*)malloc(sizeof(CsrGraph));
+    if (!csr) {
+        printf("Error: Memory allocation failed for CSR graph\n");
+        return NULL;
+    }
+    csr->numVertices = numVertices;
+    csr->mapping = NULL;
+    csr->mappingSize = 0;
+    csr->offsets = (int*)calloc(numVertices + 1, sizeof(int));
+    if (!csr->offsets) {
+        printf("Error: Memory allocation failed for CSR offsets\n");
+        free(csr);
+        return NULL;
+    }
+
+    // First pass: in-degrees, shifted by one so the prefix sum lands in place
+    int numEdges = 0;
+    for (int u = 0; u < numVertices; u++) {
+        for (Node* temp = graph->adjLists[u]; temp; temp = temp->next) {
+            csr->offsets[temp->vertex + 1]++;
+            numEdges++;
+        }
+    }
+    for (int v = 0; v < numVertices; v++) {
+        csr->offsets[v + 1] += csr->offsets[v];
+    }
+    csr->numEdges = numEdges;
+
+    csr->targets = (int*)malloc((numEdges ? numEdges : 1) * sizeof(int));
+    csr->weights = (int*)malloc((numEdges ? numEdges : 1) * sizeof(int));
+    int* fill = (int*)malloc(numVertices * sizeof(int));
+    if (!csr->targets || !csr->weights || !fill) {
+        printf("Error: Memory allocation failed for CSR edge arrays\n");
+        free(fill);
+        freeCsrGraph(csr);
+        return NULL;
+    }
+
+    // Second pass: scatter each edge into the range of its destination
+    for (int v = 0; v < numVertices; v++) {
+        fill[v] = csr->offsets[v];
+    }
+    for (int u = 0; u < numVertices; u++) {
+        for (Node* temp = graph->adjLists[u]; temp; temp = temp->next) {
+            int e = fill[temp->vertex]++;
+            csr->targets[e] = u;
+            csr->weights[e] = temp->weight;
+        }
+    }
+    free(fill);
+    return csr;
+}
+
+/**
+ * Frees all memory allocated for the CSR graph
+ */
+void freeCsrGraph(CsrGraph* csr) {
+    if (!csr) {
+        return;
+    }
+    if (csr->mapping) {
+        // Opened with openGraphFile(): the arrays live in the mapping
+        unmapGraphFile(csr->mapping, csr->mappingSize);
+    } else {
+        free(csr->offsets);
+        free(csr->targets);
+        free(csr->weights);
+    }
+    free(csr);
+}
+
+/**
+ * Index of the first edge src -> dest in the CSR arrays, or -1
+ * Scans the edge range of src with the vectorised search kernel
+ */
+int csrFindEdge(const CsrGraph* csr, int src, int dest) {
+    if (!csr || src < 0 || src >= csr->numVertices) {
+        return -1;
+    }
+    int begin = csr->offsets[src];
+    int e = searchInts(csr->targets + begin, csr->offsets[src + 1] - begin, dest);
+    return e < 0 ? -1 : begin + e;
+}
+
+/**
+ * BFS core over a CSR graph, see bfsCollect()
+ */
+static int csrBfsCollect(const CsrGraph* csr, int startVertex, TraversalContext* ctx,
+                         int* order, int* level, int* parent) {
+    if (level || parent) {
+        for (int i = 0; i < csr->numVertices; i++) {
+            if (level) level[i] = -1;
+            if (parent) parent[i] = -1;
+        }
+        if (level) level[startVertex] = 0;
+    }
+
+    resetTraversalContext(ctx);
+    Queue* queue = ctx->queue;
+    int count = 0;
+
+    markVisited(ctx, startVertex);
+    enqueue(queue, startVertex);
+    while (!isEmpty(queue)) {
+        int currentVertex = dequeue(queue);
+        if (order) order[count] = currentVertex;
+        count++;
+
+        for (int e = csr->offsets[currentVertex]; e < csr->offsets[currentVertex + 1]; e++) {
+            int adjVertex = csr->targets[e];
+            if (markVisited(ctx, adjVertex)) {
+                if (level) level[adjVertex] = level[currentVertex] + 1;
+                if (parent) parent[adjVertex] = currentVertex;
+                enqueue(queue, adjVertex);
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * Performs Breadth-First Search over a CSR graph
+ * Prints the same visit order as bfs() on the source graph
+ */
+void csrBfs(const CsrGraph* csr, int startVertex) {
+    if (!csr) {
+        printf("Error: Graph is NULL\n");
+        return;
+    }
+
+    TraversalContext* ctx = createTraversalContext(csr->numVertices);
+    if (!ctx) {
+        return;
+    }
+    csrBfsWithContext(csr, startVertex, ctx);
+    freeTraversalContext(ctx);
+}
+
+/**
+ * Performs Breadth-First Search over a CSR graph using the caller's context
+ * Safe to run from several threads at once, each with its own context
+ */
+void csrBfsWithContext(const CsrGraph* csr, int startVertex, TraversalContext* ctx) {
+    if (!csr) {
+        printf("Error: Graph is NULL\n");
+        return;
+    }
+    if (startVertex < 0 || startVertex >= csr->numVertices) {
+        printf("Error: Invalid start vertex. Must be between 0 and %d\n", csr->numVertices - 1);
+        return;
+    }
+    if (!checkContext(ctx, csr->numVertices)) {
+        return;
+    }
+
+    int count = csrBfsCollect(csr, startVertex, ctx, ctx->order, NULL, NULL);
+    printTraversal("BFS", startVertex, ctx->order, count);
+}
+
+/**
+ * Breadth-First Search over a CSR graph that writes its results, see bfsInto()
+ */
+int csrBfsInto(const CsrGraph* csr, int startVertex, TraversalContext* ctx,
+               int* order, int* level, int* parent) {
+    if (!csr || startVertex < 0 || startVertex >= csr->numVertices) {
+        return -1;
+    }
+    if (ctx) {
+        return contextFits(ctx, csr->numVertices)
+            ? csrBfsCollect(csr, startVertex, ctx, order, level, parent) : -1;
+    }
+
+    TraversalContext* temp = allocTraversalContext(csr->numVertices);
+    if (!temp) {
+        return -1;
+    }
+    int count = csrBfsCollect(csr, startVertex, temp, order, level, parent);
+    freeTraversalContext(temp);
+    return count;
+}
+
+/**
+ * DFS core over a CSR graph
+ * Keeps an explicit stack of vertices and their next edge index instead
+ * of recursing; returns the number of vertices visited
+ */
+static int csrDfsCollect(const CsrGraph* csr, int startVertex, TraversalContext* ctx,
+                         int* order, int* parent,
+                         DfsCallback preorder, DfsCallback postorder, void* arg) {
+    if (parent) {
+        for (int i = 0; i < csr->numVertices; i++) {
+            parent[i] = -1;
+        }
+    }
+
+    resetTraversalContext(ctx);
+    int* stack = ctx->stack;
+    int* cursor = ctx->cursor;
+    int count = 0;
+
+    int top = 0;
+    stack[0] = startVertex;
+    cursor[0] = csr->offsets[startVertex];
+    markVisited(ctx, startVertex);
+    if (order) order[count] = startVertex;
+    count++;
+    if (preorder) preorder(startVertex, -1, arg);
+
+    while (top >= 0) {
+        int vertex = stack[top];
+        if (cursor[top] == csr->offsets[vertex + 1]) {
+            top--;  // All edges explored, backtrack
+            if (postorder) postorder(vertex, top >= 0 ? stack[top] : -1, arg);
+            continue;
+        }
+
+        int adjVertex = csr->targets[cursor[top]++];
+        if (markVisited(ctx, adjVertex)) {
+            if (order) order[count] = adjVertex;
+            if (parent) parent[adjVertex] = vertex;
+            count++;
+            top++;
+            stack[top] = adjVertex;
+            cursor[top] = csr->offsets[adjVertex];
+            if (preorder) preorder(adjVertex, vertex, arg);
+        }
+    }
+    return count;
+}
+
+/**
+ * Performs Depth-First Search over a CSR graph
+ * Prints the same visit order as dfs() on the source graph
+ */
+void csrDfs(const CsrGraph* csr, int startVertex) {
+    if (!csr) {
+        printf("Error: Graph is NULL\n");
+        return;
+    }
+
+    TraversalContext* ctx = createTraversalContext(csr->numVertices);
+    if (!ctx) {
+        return;
+    }
+    csrDfsWithContext(csr, startVertex, ctx);
+    freeTraversalContext(ctx);
+}
+
+/**
+ * Performs Depth-First Search over a CSR graph using the caller's context
+ */
+void csrDfsWithContext(const CsrGraph* csr, int startVertex, TraversalContext* ctx) {
+    if (!csr) {
+        printf("Error: Graph is NULL\n");
+        return;
+    }
+    if (startVertex < 0 || startVertex >= csr->numVertices) {
+        printf("Error: Invalid start vertex. Must be between 0 and %d\n", csr->numVertices - 1);
+        return;
+    }
+    if (!checkContext(ctx, csr->numVertices)) {
+        return;
+    }
+
+    int count = csrDfsCollect(csr, startVertex, ctx, ctx->order, NULL, NULL, NULL, NULL);
+    printTraversal("DFS", startVertex, ctx->order, count);
+}
+
+/**
+ * Validates the input and runs csrDfsCollect(), see dfsRun()
+ */
+static int csrDfsRun(const CsrGraph* csr, int startVertex, TraversalContext* ctx,
+                     int* order, int* parent,
+                     DfsCallback preorder, DfsCallback postorder, void* arg) {
+    if (!csr || startVertex < 0 || startVertex >= csr->numVertices) {
+        return -1;
+    }
+    if (ctx) {
+        return contextFits(ctx, csr->numVertices)
+            ? csrDfsCollect(csr, startVertex, ctx, order, parent, preorder, postorder, arg) : -1;
+    }
+
+    TraversalContext* temp = allocTraversalContext(csr->numVertices);
+    if (!temp) {
+        return -1;
+    }
+    int count = csrDfsCollect(csr, startVertex, temp, order, parent, preorder, postorder, arg);
+    freeTraversalContext(temp);
+    return count;
+}
+
+/**
+ * Depth-First Search over a CSR graph that writes its results, see dfsInto()
+ */
+int csrDfsInto(const CsrGraph* csr, int startVertex, TraversalContext* ctx,
+               int* order, int* parent) {
+    return csrDfsRun(csr, startVertex, ctx, order, parent, NULL, NULL, NULL);
+}
+
+/**
+ * Depth-First Search over a CSR graph with visitor callbacks,
+ * see dfsWithCallbacks()
+ */
+int csrDfsWithCallbacks(const CsrGraph* csr, int startVertex, TraversalContext* ctx,
+                        DfsCallback preorder, DfsCallback postorder, void* arg) {
+    return csrDfsRun(csr, startVertex, ctx, NULL, NULL, preorder, postorder, arg);
+}
+
+/**
+ * Runs the selected Dijkstra strategy over a CSR graph
+ * Returns false if the priority queue could not be allocated
+ */
+static bool csrDijkstraSolve(const CsrGraph* csr, int startVertex, DijkstraMode mode,
+                             int* dist, int* pred, Bitset* visited) {
+    int numVertices = csr->numVertices;
+
+    if (mode == DIJKSTRA_DENSE) {
+        for (int count = 0; count < numVertices - 1; count++) {
+            int u = minUnvisitedDistance(dist, visited);
+            if (u == -1 || dist[u] == INT_MAX) break;
+
+            bitsetSet(visited, u);
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+                int v = csr->targets[e];
+                if (!bitsetTest(visited, v) && dist[u] + csr->weights[e] < dist[v]) {
+                    dist[v] = dist[u] + csr->weights[e];
+                    if (pred) pred[v] = u;
+                }
+            }
+        }
+        return true;
+    }
+
+    if (mode == DIJKSTRA_LAZY_HEAP) {
+        LazyHeap heap = {NULL, 0, 0};
+        bool ok = lazyHeapPush(&heap, 0, startVertex);
+
+        while (ok && heap.size > 0) {
+            HeapEntry top = lazyHeapPop(&heap);
+            int u = top.vertex;
+            if (bitsetTest(visited, u) || top.dist > dist[u]) {
+                continue;  // Stale entry, vertex was already settled
+            }
+            bitsetSet(visited, u);
+
+            for (int e = csr->offsets[u]; ok && e < csr->offsets[u + 1]; e++) {
+                int v = csr->targets[e];
+                int newDist = dist[u] + csr->weights[e];
+                if (!bitsetTest(visited, v) && newDist < dist[v]) {
+                    dist[v] = newDist;
+                    if (pred) pred[v] = u;
+                    ok = lazyHeapPush(&heap, newDist, v);
+                }
+            }
+        }
+
+        free(heap.entries);
+        return ok;
+    }
+
+    MinHeap* heap = allocMinHeap(numVertices, mode == DIJKSTRA_QUAD_HEAP ? 4 : 2, dist);
+    if (!heap) {
+        return false;
+    }
+
+    heapDecreaseKey(heap, startVertex, 0);
+    while (!heapIsEmpty(heap)) {
+        int u = heapExtractMin(heap);
+        bitsetSet(visited, u);
+
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int v = csr->targets[e];
+            if (!bitsetTest(visited, v) && dist[u] + csr->weights[e] < dist[v]) {
+                heapDecreaseKey(heap, v, dist[u] + csr->weights[e]);
+                if (pred) pred[v] = u;
+            }
+        }
+    }
+
+    freeMinHeap(heap);
+    return true;
+}
+
+/*Implements Dijkstra's shortest path algorithm over a CSR graph using a binary heap*/
+void csrDijkstra(const CsrGraph* csr, int startVertex) {
+    csrDijkstraWithMode(csr, startVertex, DIJKSTRA_BINARY_HEAP);
+}
+
+/*Implements Dijkstra's shortest path algorithm over a CSR graph with a selectable priority queue*/
+void csrDijkstraWithMode(const CsrGraph* csr, int startVertex, DijkstraMode mode) {
+    if (!csr) {
+        printf("Error: Graph is NULL\n");
+        return;
+    }
+    dijkstraRun(NULL, csr, csr->numVertices, startVertex, mode);
+}
+
+/**
+ * Dijkstra's algorithm over a CSR graph that writes its results, see dijkstraInto()
+ */
+int csrDijkstraInto(const CsrGraph* csr, int startVertex, DijkstraMode mode, int* dist, int* pred) {
+    if (!csr || !dist || startVertex < 0 || startVertex >= csr->numVertices) {
+        return -1;
+    }
+    return dijkstraCompute(NULL, csr, csr->numVertices, startVertex, mode, dist, pred) ? 0 : -1;
+}
+
+/* ========================
+ * DIRECTION-OPTIMIZING BFS
+ * ======================== */
+
+// Switch to bottom-up once the frontier's edges exceed 1/ALPHA of the unexplored edges
+#define HYBRID_BFS_ALPHA 14
+// Switch back to top-down once the frontier holds fewer than 1/BETA of the vertices
+#define HYBRID_BFS_BETA 24
+
+/**
+ * Top-down step: every frontier vertex claims its unvisited out-neighbours
+ * Returns the size of the next frontier; *nextEdges gets its out-degree sum
+ */
+static int hybridTopDownStep(const CsrGraph* csr, const int* frontier, int frontierSize,
+                             Bitset* visited, int* next, int* level, int* parent,
+                             long long* nextEdges) {
+    int nextSize = 0;
+    long long edges = 0;
+
+    for (int i = 0; i < frontierSize; i++) {
+        int u = frontier[i];
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int v = csr->targets[e];
+            if (bitsetSet(visited, v)) {
+                level[v] = level[u] + 1;
+                if (parent) parent[v] = u;
+                next[nextSize++] = v;
+                edges += csr->offsets[v + 1] - csr->offsets[v];
+            }
+        }
+    }
+    *nextEdges = edges;
+    return nextSize;
+}
+
+/**
+ * Bottom-up step: every unvisited vertex looks for any in-neighbour in the
+ * frontier set and stops at the first one it finds
+ * Unvisited vertices are found a word at a time, skipping visited runs
+ * Returns the size of the next frontier; *nextEdges gets its out-degree sum
+ */
+static int hybridBottomUpStep(const CsrGraph* csr, const CsrGraph* transpose,
+                              const Bitset* frontierBits, Bitset* visited, int depth,
+                              int* next, int* level, int* parent, long long* nextEdges) {
+    int nextSize = 0;
+    long long edges = 0;
+
+    for (int w = 0; w < visited->numWords; w++) {
+        uint64_t unvisited = ~visited->words[w];
+        if (w == visited->numWords - 1 && (visited->numBits & 63)) {
+            unvisited &= ((uint64_t)1 << (visited->numBits & 63)) - 1;
+        }
+        while (unvisited) {
+            int v = (w << 6) + wordLowestBit(unvisited);
+            unvisited &= unvisited - 1;
+            for (int e = transpose->offsets[v]; e < transpose->offsets[v + 1]; e++) {
+                int u = transpose->targets[e];
+                if (bitsetTest(frontierBits, u)) {
+                    bitsetSet(visited, v);
+                    level[v] = depth + 1;
+                    if (parent) parent[v] = u;
+                    next[nextSize++] = v;
+                    edges += csr->offsets[v + 1] - csr->offsets[v];
+                    break;
+                }
+            }
+        }
+    }
+    *nextEdges = edges;
+    return nextSize;
+}
+
+/**
+ * Core of csrHybridBfsInto(); level must be a valid array
+ * Returns the number of vertices reached, or -1 if allocation fails
+ */
+static int hybridBfsCollect(const CsrGraph* csr, const CsrGraph* transpose, int startVertex,
+                            int* level, int* parent) {
+    int numVertices = csr->numVertices;
+    int* frontier = (int*)malloc(numVertices * sizeof(int));
+    int* next = (int*)malloc(numVertices * sizeof(int));
+    Bitset* frontierBits = allocBitset(numVertices);
+    Bitset* visited = allocBitset(numVertices);
+    if (!frontier || !next || !frontierBits || !visited) {
+        free(frontier);
+        free(next);
+        freeBitset(frontierBits);
+        freeBitset(visited);
+        return -1;
+    }
+
+    for (int i = 0; i < numVertices; i++) {
+        level[i] = -1;
+        if (parent) parent[i] = -1;
+    }
+    level[startVertex] = 0;
+    bitsetSet(visited, startVertex);
+    frontier[0] = startVertex;
+    int frontierSize = 1;
+    int reached = 1;
+    int depth = 0;
+    bool bottomUp = false;
+    long long frontierEdges = csr->offsets[startVertex + 1] - csr->offsets[startVertex];
+    long long unexploredEdges = csr->numEdges;
+
+    while (frontierSize > 0) {
+        // Beamer's heuristic: go bottom-up while the frontier is heavy
+        if (!bottomUp && frontierEdges > unexploredEdges / HYBRID_BFS_ALPHA) {
+            bottomUp = true;
+        } else if (bottomUp && frontierSize < numVertices / HYBRID_BFS_BETA) {
+            bottomUp = false;
+        }
+        unexploredEdges -= frontierEdges;
+
+        int nextSize;
+        if (bottomUp) {
+            bitsetClearAll(frontierBits);
+            for (int i = 0; i < frontierSize; i++) {
+                bitsetSet(frontierBits, frontier[i]);
+            }
+            nextSize = hybridBottomUpStep(csr, transpose, frontierBits, visited, depth,
+                                          next, level, parent, &frontierEdges);
+        } else {
+            nextSize = hybridTopDownStep(csr, frontier, frontierSize, visited,
+                                         next, level, parent, &frontierEdges);
+        }
+
+        int* swap = frontier;
+        frontier = next;
+        next = swap;
+        frontierSize = nextSize;
+        reached += nextSize;
+        depth++;
+    }
+
+    free(frontier);
+    free(next);
+    freeBitset(frontierBits);
+    freeBitset(visited);
+    return reached;
+}
+
+/**
+ * Direction-optimizing (top-down/bottom-up) BFS that writes its results
+ * transpose must come from createTransposeCsrGraph() on the same graph;
+ * level and parent are optional buffers of numVertices ints (-1 if
+ * unreached). Levels match bfs(); parents may be any vertex one level up
+ * Returns the number of vertices reached, or -1 on invalid input
+ */
+int csrHybridBfsInto(const CsrGraph* csr, const CsrGraph* transpose, int startVertex,
+                     int* level, int* parent) {
+    if (!csr || !transpose || transpose->numVertices != csr->numVertices ||
+        startVertex < 0 || startVertex >= csr->numVertices) {
+        return -1;
+    }
+    if (level) {
+        return hybridBfsCollect(csr, transpose, startVertex, level, parent);
+    }
+
+    int* temp = (int*)malloc(csr->numVertices * sizeof(int));
+    if (!temp) {
+        return -1;
+    }
+    int reached = hybridBfsCollect(csr, transpose, startVertex, temp, parent);
+    free(temp);
+    return reached;
+}
+
+/**
+ * Performs direction-optimizing BFS and prints the level of every vertex
+ */
+void csrHybridBfs(const CsrGraph* csr, const CsrGraph* transpose, int startVertex) {
+    if (!csr || !transpose) {
+        printf("Error: Graph is NULL\n");
+        return;
+    }
+    if (startVertex < 0 || startVertex >= csr->numVertices) {
+        printf("Error: Invalid start vertex. Must be between 0 and %d\n", csr->numVertices - 1);
+        return;
+    }
+    if (transpose->numVertices != csr->numVertices) {
+        printf("Error: Transpose has %d vertices, graph has %d\n",
+               transpose->numVertices, csr->numVertices);
+        return;
+    }
+
+    int* level = (int*)malloc(csr->numVertices * sizeof(int));
+    if (!level || hybridBfsCollect(csr, transpose, startVertex, level, NULL) < 0) {
+        printf("Error: Memory allocation failed for BFS\n");
+        free(level);
+        return;
+    }
+
+    printf("\n=== Hybrid BFS starting from vertex %d ===\n", startVertex);
+    printf("Vertex\tLevel\n");
+    for (int i = 0; i < csr->numVertices; i++) {
+        if (level[i] == -1) {
+            printf("%d\tUNREACHABLE\n", i);
+        } else {
+            printf("%d\t%d\n", i, level[i]);
+        }
+    }
+    printf("=======================================\n\n");
+    free(level);
+}
+
+/* ========================
+ * PARALLEL BFS
+ * ======================== */
+
+// Frontiers smaller than this are expanded on the calling thread only
+#define PARALLEL_BFS_MIN_FRONTIER 1024
+
+/*Growable per-thread buffer holding the vertices a thread discovered*/
+typedef struct LocalFrontier {
+    int* items;
+    int size;
+    int capacity;
+    bool failed;         // Set if the buffer could not be grown
+} LocalFrontier;
+
+/*State shared by all threads of one parallel BFS*/
+typedef struct ParallelBfs {
+    Graph* graph;              // Adjacency lists, or NULL when csr is used
+    const CsrGraph* csr;       // CSR snapshot, or NULL when graph is used
+    const int* frontier;       // Vertices of the current level, in BFS order
+    int frontierSize;
+    int depth;                 // Level of the current frontier
+    int numParts;              // Contiguous frontier slices for this level
+    atomic_int* owner;         // Smallest frontier position that reached each vertex
+    atomic_uchar* visited;     // Claimed with compare-and-swap
+    int* level;                // Optional output
+    int* parent;               // Optional output
+    LocalFrontier* locals;     // One buffer per slice
+} ParallelBfs;
+
+/**
+ * Appends a vertex to a local frontier, growing it when needed
+ */
+static void localFrontierPush(LocalFrontier* local, int vertex) {
+    if (local->size == local->capacity) {
+        int capacity = local->capacity ? 2 * local->capacity : 256;
+        int* grown = (int*)realloc(local->items, capacity * sizeof(int));
+        if (!grown) {
+            local->failed = true;
+            return;
+        }
+        local->items = grown;
+        local->capacity = capacity;
+    }
+    local->items[local->size++] = vertex;
+}
+
+/**
+ * Phase 1: every frontier vertex proposes its position as the owner of
+ * each unvisited neighbour; the smallest position wins, which is the
+ * vertex sequential BFS would have dequeued first
+ */
+static void parallelBfsPropose(void* arg, int index, int numThreads) {
+    ParallelBfs* state = (ParallelBfs*)arg;
+    (void)numThreads;
+    if (index >= state->numParts) {
+        return;
+    }
+    int begin = (int)((long long)state->frontierSize * index / state->numParts);
+    int end = (int)((long long)state->frontierSize * (index + 1) / state->numParts);
+
+    for (int pos = begin; pos < end; pos++) {
+        int u = state->frontier[pos];
+        int e = 0, last = 0;
+        Node* temp = NULL;
+        if (state->csr) {
+            e = state->csr->offsets[u];
+            last = state->csr->offsets[u + 1];
+        } else {
+            temp = state->graph->adjLists[u];
+        }
+
+        while (state->csr ? e < last : temp != NULL) {
+            int v = state->csr ? state->csr->targets[e++] : temp->vertex;
+            if (!state->csr) temp = temp->next;
+
+            if (atomic_load_explicit(&state->visited[v], memory_order_relaxed)) {
+                continue;
+            }
+            int current = atomic_load_explicit(&state->owner[v], memory_order_relaxed);
+            while (pos < current &&
+                   !atomic_compare_exchange_weak_explicit(&state->owner[v], &current, pos,
+                                                          memory_order_relaxed,
+                                                          memory_order_relaxed)) {
+            }
+        }
+    }
+}
+
+/**
+ * Phase 2: each frontier vertex claims the neighbours it owns, in edge
+ * order, and appends them to its slice's local frontier
+ */
+static void parallelBfsClaim(void* arg, int index, int numThreads) {
+    ParallelBfs* state = (ParallelBfs*)arg;
+    (void)numThreads;
+    if (index >= state->numParts) {
+        return;
+    }
+    LocalFrontier* local = &state->locals[index];
+    int begin = (int)((long long)state->frontierSize * index / state->numParts);
+    int end = (int)((long long)state->frontierSize * (index + 1) / state->numParts);
+    local->size = 0;
+
+    for (int pos = begin; pos < end; pos++) {
+        int u = state->frontier[pos];
+        int e = 0, last = 0;
+        Node* temp = NULL;
+        if (state->csr) {
+            e = state->csr->offsets[u];
+            last = state->csr->offsets[u + 1];
+        } else {
+            temp = state->graph->adjLists[u];
+        }
+
+        while (state->csr ? e < last : temp != NULL) {
+            int v = state->csr ? state->csr->targets[e++] : temp->vertex;
+            if (!state->csr) temp = temp->next;
+
+            if (atomic_load_explicit(&state->owner[v], memory_order_relaxed) != pos) {
+                continue;
+            }
+            unsigned char expected = 0;
+            if (atomic_compare_exchange_strong_explicit(&state->visited[v], &expected, 1,
+                                                        memory_order_relaxed,
+                                                        memory_order_relaxed)) {
+                if (state->level) state->level[v] = state->depth + 1;
+                if (state->parent) state->parent[v] = u;
+                localFrontierPush(local, v);
+            }
+        }
+    }
+}
+
+/**
+ * Core of parallelBfsInto() and csrParallelBfsInto()
+ * order must hold numVertices ints; frontiers are consecutive slices of it
+ * Returns the number of vertices visited, or -1 if allocation fails
+ */
+static int parallelBfsCollect(Graph* graph, const CsrGraph* csr, int numVertices,
+                              ThreadPool* pool, int startVertex,
+                              int* order, int* level, int* parent) {
+    int numThreads = threadPoolSize(pool);
+    ParallelBfs state;
+    state.graph = graph;
+    state.csr = csr;
+    state.level = level;
+    state.parent = parent;
+    state.owner = (atomic_int*)malloc(numVertices * sizeof(atomic_int));
+    state.visited = (atomic_uchar*)malloc(numVertices * sizeof(atomic_uchar));
+    state.locals = (LocalFrontier*)calloc(numThreads, sizeof(LocalFrontier));
+    if (!state.owner || !state.visited || !state.locals) {
+        free(state.owner);
+        free(state.visited);
+        free(state.locals);
+        return -1;
+    }
+
+    for (int i = 0; i < numVertices; i++) {
+        atomic_init(&state.owner[i], INT_MAX);
+        atomic_init(&state.visited[i], 0);
+        if (level) level[i] = -1;
+        if (parent) parent[i] = -1;
+    }
+    if (level) level[startVertex] = 0;
+    atomic_store(&state.visited[startVertex], 1);
+    order[0] = startVertex;
+
+    int levelStart = 0;
+    int levelEnd = 1;
+    bool failed = false;
+    state.depth = 0;
+
+    while (levelStart < levelEnd && !failed) {
+        state.frontier = order + levelStart;
+        state.frontierSize = levelEnd - levelStart;
+        state.numParts = state.frontierSize < PARALLEL_BFS_MIN_FRONTIER ? 1 : numThreads;
+
+        if (state.numParts == 1) {
+            parallelBfsPropose(&state, 0, 1);
+            parallelBfsClaim(&state, 0, 1);
+        } else {
+            threadPoolRun(pool, parallelBfsPropose, &state);
+            threadPoolRun(pool, parallelBfsClaim, &state);
+        }
+
+        // Concatenating the slices in order reproduces sequential BFS order
+        int next = levelEnd;
+        for (int t = 0; t < state.numParts; t++) {
+            LocalFrontier* local = &state.locals[t];
+            failed = failed || local->failed;
+            for (int i = 0; i < local->size; i++) {
+                order[next++] = local->items[i];
+            }
+        }
+        levelStart = levelEnd;
+        levelEnd = next;
+        state.depth++;
+    }
+
+    for (int t = 0; t < numThreads; t++) {
+        free(state.locals[t].items);
+    }
+    free(state.locals);
+    free(state.owner);
+    free(state.visited);
+    return failed ? -1 : levelEnd;
+}
+
+/**
+ * Shared argument checks and buffer handling for the parallel BFS entry points
+ */
+static int parallelBfsRun(Graph* graph, const CsrGraph* csr, int numVertices,
+                          ThreadPool* pool, int startVertex,
+                          int* order, int* level, int* parent) {
+    if (startVertex < 0 || startVertex >= numVertices) {
+        return -1;
+    }
+    if (order) {
+        return parallelBfsCollect(graph, csr, numVertices, pool, startVertex, order, level, parent);
+    }
+
+    int* temp = (int*)malloc(numVertices * sizeof(int));
+    if (!temp) {
+        return -1;
+    }
+    int count = parallelBfsCollect(graph, csr, numVertices, pool, startVertex, temp, level, parent);
+    free(temp);
+    return count;
+}
+
+/**
+ * Level-synchronous BFS that splits each frontier across a thread pool
+ * order, level and parent are optional buffers of numVertices ints and
+ * receive exactly what bfsInto() writes; pool may be NULL (one thread)
+ * The graph must not be modified while the search runs
+ * Returns the number of vertices visited, or -1 on invalid input
+ */
+int parallelBfsInto(Graph* graph, ThreadPool* pool, int startVertex,
+                    int* order, int* level, int* parent) {
+    if (!graph) {
+        return -1;
+    }
+    return parallelBfsRun(graph, NULL, graph->numVertices, pool, startVertex, order, level, parent);
+}
+
+/**
+ * Level-synchronous parallel BFS over a CSR graph, see parallelBfsInto()
+ */
+int csrParallelBfsInto(const CsrGraph* csr, ThreadPool* pool, int startVertex,
+                       int* order, int* level, int* parent) {
+    if (!csr) {
+        return -1;
+    }
+    return parallelBfsRun(NULL, csr, csr->numVertices, pool, startVertex, order, level, parent);
+}
+
+/* ========================
+ * DELTA-STEPPING SHORTEST PATHS
+ * ======================== */
+
+// Vertex lists smaller than this are relaxed on the calling thread only
+#define DELTA_STEPPING_MIN_PARALLEL 1024
+// Most buckets one run allocates; delta is widened to stay within it
+#define DELTA_STEPPING_MAX_BUCKETS 65536
+
+/*Growable list of vertices, used for buckets and per-thread requests*/
+typedef struct VertexList {
+    int* items;
+    int size;
+    int capacity;
+} VertexList;
+
+/*State shared by all threads of one delta-stepping run*/
+typedef struct DeltaStepping {
+    Graph* graph;              // Adjacency lists, or NULL when csr is used
+    const CsrGraph* csr;       // CSR snapshot, or NULL when graph is used
+    atomic_int* dist;          // Tentative distances
+    int delta;                 // Bucket width
+    const int* sources;        // Vertices whose edges are relaxed this phase
+    int numSources;
+    bool heavy;                // Relax heavy (w > delta) instead of light edges
+    int numParts;              // Contiguous slices of sources for this phase
+    VertexList* locals;        // Improved vertices found by each slice
+    bool* failed;              // Set by a slice whose list could not grow
+} DeltaStepping;
+
+/**
+ * Appends a vertex to a list, growing it when needed
+ * Returns false if the list could not be grown
+ */
+static bool vertexListPush(VertexList* list, int vertex) {
+    if (list->size == list->capacity) {
+        int capacity = list->capacity ? 2 * list->capacity : 64;
+        int* grown = (int*)realloc(list->items, capacity * sizeof(int));
+        if (!grown) {
+            return false;
+        }
+        list->items = grown;
+        list->capacity = capacity;
+    }
+    list->items[list->size++] = vertex;
+    return true;
+}
+
+/**
+ * Relaxes the light or heavy edges of one slice of the sources
+ * Distances are lowered with an atomic compare-and-swap minimum; every
+ * vertex whose distance improved is recorded in the slice's list
+ */
+static void deltaSteppingRelax(void* arg, int index, int numThreads) {
+    DeltaStepping* state = (DeltaStepping*)arg;
+    (void)numThreads;
+    if (index >= state->numParts) {
+        return;
+    }
+    VertexList* local = &state->locals[index];
+    int begin = (int)((long long)state->numSources * index / state->numParts);
+    int end = (int)((long long)state->numSources * (index + 1) / state->numParts);
+    local->size = 0;
+
+    for (int i = begin; i < end; i++) {
+        int u = state->sources[i];
+        int du = atomic_load_explicit(&state->dist[u], memory_order_relaxed);
+        int e = 0, last = 0;
+        Node* temp = NULL;
+        if (state->csr) {
+            e = state->csr->offsets[u];
+            last = state->csr->offsets[u + 1];
+        } else {
+            temp = state->graph->adjLists[u];
+        }
+
+        while (state->csr ? e < last : temp != NULL) {
+            int v, weight;
+            if (state->csr) {
+                v = state->csr->targets[e];
+                weight = state->csr->weights[e];
+                e++;
+            } else {
+                v = temp->vertex;
+                weight = temp->weight;
+                temp = temp->next;
+            }
+            if ((weight > state->delta) != state->heavy) {
+                continue;
+            }
+
+            // A path longer than INT_MAX would overflow; leave it unreached
+            long long newDist = (long long)du + weight;
+            if (newDist >= INT_MAX) {
+                continue;
+            }
+            int current = atomic_load_explicit(&state->dist[v], memory_order_relaxed);
+            while (newDist < current) {
+                if (atomic_compare_exchange_weak_explicit(&state->dist[v], &current, (int)newDist,
+                                                          memory_order_relaxed,
+                                                          memory_order_relaxed)) {
+                    if (!vertexListPush(local, v)) {
+                        state->failed[index] = true;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Runs one relaxation phase over sources and files every improved vertex
+ * into the bucket of its new distance
+ * Returns false if a list could not be grown
+ */
+static bool deltaSteppingPhase(DeltaStepping* state, ThreadPool* pool,
+                               const int* sources, int numSources, bool heavy,
+                               VertexList* buckets, int numBuckets) {
+    state->sources = sources;
+    state->numSources = numSources;
+    state->heavy = heavy;
+    state->numParts = numSources < DELTA_STEPPING_MIN_PARALLEL ? 1 : threadPoolSize(pool);
+
+    if (state->numParts == 1) {
+        deltaSteppingRelax(state, 0, 1);
+    } else {
+        threadPoolRun(pool, deltaSteppingRelax, state);
+    }
+
+    bool ok = true;
+    for (int t = 0; t < state->numParts; t++) {
+        ok = ok && !state->failed[t];
+        VertexList* local = &state->locals[t];
+        for (int i = 0; ok && i < local->size; i++) {
+            int v = local->items[i];
+            int bucket = atomic_load_explicit(&state->dist[v], memory_order_relaxed) / state->delta;
+            ok = vertexListPush(&buckets[bucket % numBuckets], v);
+        }
+    }
+    return ok;
+}
+
+/**
+ * Core of deltaSteppingInto() and csrDeltaSteppingInto()
+ * Buckets are reused cyclically: all pending distances lie within
+ * maxWeight of the current bucket, so maxWeight / delta + 2 buckets suffice.
+ * At most numVertices of them hold live entries, so delta is widened when the
+ * count would pass that (or DELTA_STEPPING_MAX_BUCKETS); any delta gives
+ * the same distances
+ * Returns false on a negative weight or if memory allocation fails
+ */
+static bool deltaSteppingCollect(Graph* graph, const CsrGraph* csr, int numVertices,
+                                 ThreadPool* pool, int startVertex, int delta, int* dist) {
+    // Largest weight and average degree pick the bucket count and default delta
+    int maxWeight = 0;
+    int minWeight = 0;
+    long long numEdges = 0;
+    for (int u = 0; u < numVertices; u++) {
+        if (csr) {
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+                if (csr->weights[e] > maxWeight) maxWeight = csr->weights[e];
+                if (csr->weights[e] < minWeight) minWeight = csr->weights[e];
+            }
+            numEdges += csr->offsets[u + 1] - csr->offsets[u];
+        } else {
+            for (Node* temp = graph->adjLists[u]; temp; temp = temp->next) {
+                if (temp->weight > maxWeight) maxWeight = temp->weight;
+                if (temp->weight < minWeight) minWeight = temp->weight;
+                numEdges++;
+            }
+        }
+    }
+    if (minWeight < 0) {
+        return false;  // Buckets only move forward, negative weights are unsupported
+    }
+    if (delta <= 0) {
+        long long avgDegree = numEdges / numVertices;
+        delta = (int)(maxWeight / (avgDegree > 1 ? avgDegree : 1));
+        if (delta <= 0) delta = 1;
+    }
+
+    long long maxBuckets = numVertices < DELTA_STEPPING_MAX_BUCKETS ? numVertices + 2
+                                                                   : DELTA_STEPPING_MAX_BUCKETS + 2;
+    if ((long long)maxWeight / delta + 2 > maxBuckets) {
+        delta = (int)((maxWeight + (maxBuckets - 2) - 1) / (maxBuckets - 2));
+    }
+
+    int numThreads = threadPoolSize(pool);
+    int numBuckets = (int)(maxWeight / delta + 2);
+    DeltaStepping state;
+    state.graph = graph;
+    state.csr = csr;
+    state.delta = delta;
+    state.dist = (atomic_int*)malloc(numVertices * sizeof(atomic_int));
+    state.locals = (VertexList*)calloc(numThreads, sizeof(VertexList));
+    state.failed = (bool*)calloc(numThreads, sizeof(bool));
+    VertexList* buckets = (VertexList*)calloc(numBuckets, sizeof(VertexList));
+    int* roundStamp = (int*)malloc(numVertices * sizeof(int));
+    VertexList current = {NULL, 0, 0};
+    VertexList settled = {NULL, 0, 0};
+    bool ok = state.dist && state.locals && state.failed && buckets && roundStamp;
+
+    if (ok) {
+        for (int i = 0; i < numVertices; i++) {
+            atomic_init(&state.dist[i], INT_MAX);
+            roundStamp[i] = -1;
+        }
+        atomic_store(&state.dist[startVertex], 0);
+        ok = vertexListPush(&buckets[0], startVertex);
+    }
+
+    int round = 0;
+    for (long long bucket = 0; ok; bucket++) {
+        // Find the next non-empty bucket, at most one full cycle ahead
+        int empty = 0;
+        while (empty < numBuckets && buckets[bucket % numBuckets].size == 0) {
+            bucket++;
+            empty++;
+        }
+        if (empty == numBuckets) {
+            break;
+        }
+        VertexList* active = &buckets[bucket % numBuckets];
+        settled.size = 0;
+
+        // Light edges may refill the current bucket, so repeat until it stays empty
+        while (ok && active->size > 0) {
+            current.size = 0;
+            for (int i = 0; ok && i < active->size; i++) {
+                int v = active->items[i];
+                int d = atomic_load_explicit(&state.dist[v], memory_order_relaxed);
+                // Skip stale entries and duplicates within this round
+                if (d / delta != bucket || roundStamp[v] == round) {
+                    continue;
+                }
+                roundStamp[v] = round;
+                ok = vertexListPush(&current, v) && vertexListPush(&settled, v);
+            }
+            active->size = 0;
+            round++;
+            if (ok && current.size > 0) {
+                ok = deltaSteppingPhase(&state, pool, current.items, current.size, false,
+                                        buckets, numBuckets);
+            }
+        }
+
+        // Heavy edges always land in later buckets, so one pass is enough
+        if (ok && settled.size > 0) {
+            current.size = 0;
+            for (int i = 0; ok && i < settled.size; i++) {
+                int v = settled.items[i];
+                if (roundStamp[v] != -2) {
+                    roundStamp[v] = -2;
+                    ok = vertexListPush(&current, v);
+                }
+            }
+            ok = ok && deltaSteppingPhase(&state, pool, current.items, current.size, true,
+                                          buckets, numBuckets);
+        }
+    }
+
+    if (ok) {
+        for (int i = 0; i < numVertices; i++) {
+            dist[i] = atomic_load_explicit(&state.dist[i], memory_order_relaxed);
+        }
+    }
+    for (int t = 0; state.locals && t < numThreads; t++) {
+        free(state.locals[t].items);
+    }
+    for (int b = 0; buckets && b < numBuckets; b++) {
+        free(buckets[b].items);
+    }
+    free(current.items);
+    free(settled.items);
+    free(roundStamp);
+    free(buckets);
+    free(state.failed);
+    free(state.locals);
+    free(state.dist);
+    return ok;
+}
+
+/**
+ * Delta-stepping single-source shortest paths across a thread pool
+ * Writes the same distances as dijkstraInto() (INT_MAX if unreachable);
+ * weights must be non-negative. delta <= 0 picks max weight / avg degree
+ * pool may be NULL to run on the calling thread
+ * Returns 0 on success, -1 on invalid input, a negative weight or
+ * allocation failure
+ */
+int deltaSteppingInto(Graph* graph, ThreadPool* pool, int startVertex, int delta, int* dist) {
+    if (!graph || !dist || startVertex < 0 || startVertex >= graph->numVertices) {
+        return -1;
+    }
+    return deltaSteppingCollect(graph, NULL, graph->numVertices, pool,
+                                startVertex, delta, dist) ? 0 : -1;
+}
+
+/**
+ * Delta-stepping shortest paths over a CSR graph, see deltaSteppingInto()
+ */
+int csrDeltaSteppingInto(const CsrGraph* csr, ThreadPool* pool, int startVertex, int delta,
+                         int* dist) {
+    if (!csr || !dist || startVertex < 0 || startVertex >= csr->numVertices) {
+        return -1;
+    }
+    return deltaSteppingCollect(NULL, csr, csr->numVertices, pool,
+                                startVertex, delta, dist) ? 0 : -1;
 }
\ No newline at end of file
@@ -0,0 +1,1050 @@
+#include "dshelp.h"
+#include <ctype.h>
+#include <stdatomic.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+/* ====================
+ * BINARY GRAPH FILES
+ * ==================== */
+
+/*
+File layout, in the byte order of the machine that wrote it:
+  header   GraphFileHeader, 64 bytes
+  offsets  numVertices + 1 int32 values at offsetsPos
+  targets  numEdges int32 values at targetsPos
+  weights  numEdges int32 values at weightsPos
+Sections start on 64-byte boundaries, so once mapped every array is
+aligned and can be used in place as a CsrGraph.
+*/
+#define GRAPH_FILE_MAGIC "DSHGRAPH"
+#define GRAPH_FILE_VERSION 1
+#define GRAPH_FILE_BYTE_ORDER 0x01020304u
+#define GRAPH_FILE_ALIGN 64
+
+// Edges staged per fwrite when streaming adjacency lists
+#define GRAPH_FILE_BUFFER 4096
+
+typedef struct GraphFileHeader {
+    char magic[8];           // GRAPH_FILE_MAGIC, not NUL terminated
+    uint32_t version;        // GRAPH_FILE_VERSION
+    uint32_t byteOrder;      // GRAPH_FILE_BYTE_ORDER as stored by the writer
+    int32_t numVertices;
+    int32_t numEdges;
+    uint64_t offsetsPos;     // Byte position of each section
+    uint64_t targetsPos;
+    uint64_t weightsPos;
+    uint64_t fileSize;       // Lets the loader reject truncated files
+    uint8_t reserved[8];     // Zero
+} GraphFileHeader;
+
+static uint64_t alignSection(uint64_t pos) {
+    return (pos + GRAPH_FILE_ALIGN - 1) & ~(uint64_t)(GRAPH_FILE_ALIGN - 1);
+}
+
+/**
+ * Writes zero bytes from position from up to position to
+ */
+static bool writePadding(FILE* out, uint64_t from, uint64_t to) {
+    static const char zeros[GRAPH_FILE_ALIGN];
+    return to == from || fwrite(zeros, 1, (size_t)(to - from), out) == to - from;
+}
+
+/**
+ * Streams the targets or weights of every adjacency list in CSR order
+ */
+static bool writeAdjacency(FILE* out, Graph* graph, bool weights) {
+    int buffer[GRAPH_FILE_BUFFER];
+    int count = 0;
+
+    for (int v = 0; v < graph->numVertices; v++) {
+        for (Node* temp = graph->adjLists[v]; temp; temp = temp->next) {
+            buffer[count++] = weights ? temp->weight : temp->vertex;
+            if (count == GRAPH_FILE_BUFFER) {
+                if (fwrite(buffer, sizeof(int), count, out) != (size_t)count) {
+                    return false;
+                }
+                count = 0;
+            }
+        }
+    }
+    return fwrite(buffer, sizeof(int), count, out) == (size_t)count;
+}
+
+/**
+ * Shared writer for saveGraphFile() and saveCsrGraphFile()
+ * Exactly one of graph and csr is non-NULL; adjacency lists are written
+ * straight to the file without building a CSR copy in memory
+ * Returns 0 on success, -1 on failure
+ */
+static int writeGraphFile(Graph* graph, const CsrGraph* csr, const char* path) {
+    int numVertices = graph ? graph->numVertices : csr->numVertices;
+    const int* offsets = csr ? csr->offsets : NULL;
+    int* degrees = NULL;
+
+    if (graph) {
+        degrees = (int*)malloc((numVertices + 1) * sizeof(int));
+        if (!degrees) {
+            printf("Error: Memory allocation failed for graph file offsets\n");
+            return -1;
+        }
+        long long numEdges = 0;
+        for (int v = 0; v < numVertices; v++) {
+            degrees[v] = (int)numEdges;
+            for (Node* temp = graph->adjLists[v]; temp; temp = temp->next) {
+                numEdges++;
+            }
+        }
+        if (numEdges > INT_MAX) {
+            printf("Error: Graph has too many edges for a graph file\n");
+            free(degrees);
+            return -1;
+        }
+        degrees[numVertices] = (int)numEdges;
+        offsets = degrees;
+    }
+
+    GraphFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_FILE_VERSION;
+    header.byteOrder = GRAPH_FILE_BYTE_ORDER;
+    header.numVertices = numVertices;
+    header.numEdges = offsets[numVertices];
+    header.offsetsPos = alignSection(sizeof(GraphFileHeader));
+    header.targetsPos = alignSection(header.offsetsPos + (uint64_t)(numVertices + 1) * sizeof(int));
+    header.weightsPos = alignSection(header.targetsPos + (uint64_t)header.numEdges * sizeof(int));
+    header.fileSize = header.weightsPos + (uint64_t)header.numEdges * sizeof(int);
+
+    FILE* out = fopen(path, "wb");
+    if (!out) {
+        printf("Error: Cannot open %s for writing\n", path);
+        free(degrees);
+        return -1;
+    }
+
+    size_t numOffsets = (size_t)numVertices + 1;
+    size_t numEdges = (size_t)header.numEdges;
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+              writePadding(out, sizeof(header), header.offsetsPos) &&
+              fwrite(offsets, sizeof(int), numOffsets, out) == numOffsets &&
+              writePadding(out, header.offsetsPos + numOffsets * sizeof(int), header.targetsPos);
+    if (ok) {
+        ok = graph ? writeAdjacency(out, graph, false)
+                   : fwrite(csr->targets, sizeof(int), numEdges, out) == numEdges;
+    }
+    ok = ok && writePadding(out, header.targetsPos + numEdges * sizeof(int), header.weightsPos);
+    if (ok) {
+        ok = graph ? writeAdjacency(out, graph, true)
+                   : fwrite(csr->weights, sizeof(int), numEdges, out) == numEdges;
+    }
+    // fclose flushes the last buffer, so its result counts too
+    ok = (fclose(out) == 0) && ok;
+    free(degrees);
+
+    if (!ok) {
+        printf("Error: Failed to write graph file %s\n", path);
+        remove(path);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Saves the graph in the binary CSR file format, see openGraphFile()
+ * Returns 0 on success, -1 on failure
+ */
+int saveGraphFile(Graph* graph, const char* path) {
+    if (!graph || !path) {
+        printf("Error: Graph or path is NULL\n");
+        return -1;
+    }
+    return writeGraphFile(graph, NULL, path);
+}
+
+/**
+ * Saves a CSR snapshot in the binary CSR file format
+ * Returns 0 on success, -1 on failure
+ */
+int saveCsrGraphFile(const CsrGraph* csr, const char* path) {
+    if (!csr || !path) {
+        printf("Error: CSR graph or path is NULL\n");
+        return -1;
+    }
+    return writeGraphFile(NULL, csr, path);
+}
+
+/**
+ * Maps a whole file of at least minSize bytes read-only and shared
+ * Returns NULL on failure; *size receives the file size
+ */
+static void* mapGraphFile(const char* path, size_t minSize, size_t* size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+    LARGE_INTEGER length;
+    void* base = NULL;
+    if (GetFileSizeEx(file, &length) && length.QuadPart >= (LONGLONG)minSize &&
+        (unsigned long long)length.QuadPart <= SIZE_MAX) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            // The view keeps the mapping alive once both handles are closed
+            CloseHandle(mapping);
+        }
+        *size = (size_t)length.QuadPart;
+    }
+    CloseHandle(file);
+    return base;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat info;
+    void* base = NULL;
+    if (fstat(fd, &info) == 0 && info.st_size >= (off_t)minSize &&
+        (unsigned long long)info.st_size <= SIZE_MAX) {
+        base = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) {
+            base = NULL;
+        }
+        *size = (size_t)info.st_size;
+    }
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    return base;
+#endif
+}
+
+/**
+ * Releases a mapping made by mapGraphFile(); called by freeCsrGraph()
+ */
+void unmapGraphFile(void* mapping, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(mapping);
+#else
+    munmap(mapping, size);
+#endif
+}
+
+/**
+ * Checks that a section of count ints lies inside the file and is aligned
+ */
+static bool sectionFits(uint64_t pos, uint64_t count, size_t size) {
+    return pos % sizeof(int) == 0 && pos <= size && count <= (size - pos) / sizeof(int);
+}
+
+/**
+ * Opens a file written by saveGraphFile() as a CSR graph without copying
+ * The arrays point straight into a read-only shared mapping, so loading
+ * costs O(1) and processes opening the same file share its pages.
+ * Only the header and section bounds are checked; run verifyCsrGraph()
+ * before traversing files from untrusted sources
+ * Free the result with freeCsrGraph()
+ */
+CsrGraph* openGraphFile(const char* path) {
+    if (!path) {
+        printf("Error: Path is NULL\n");
+        return NULL;
+    }
+
+    size_t size = 0;
+    char* base = (char*)mapGraphFile(path, sizeof(GraphFileHeader), &size);
+    if (!base) {
+        printf("Error: Cannot map graph file %s\n", path);
+        return NULL;
+    }
+
+    const GraphFileHeader* header = (const GraphFileHeader*)base;
+    const char* problem = NULL;
+    if (memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(header->magic)) != 0) {
+        problem = "not a graph file";
+    } else if (header->version != GRAPH_FILE_VERSION) {
+        problem = "unsupported graph file version";
+    } else if (header->byteOrder != GRAPH_FILE_BYTE_ORDER) {
+        problem = "graph file was written with a different byte order";
+    } else if (header->fileSize != size) {
+        problem = "graph file is truncated";
+    } else if (header->numVertices <= 0 || header->numEdges < 0 ||
+               !sectionFits(header->offsetsPos, (uint64_t)header->numVertices + 1, size) ||
+               !sectionFits(header->targetsPos, (uint64_t)header->numEdges, size) ||
+               !sectionFits(header->weightsPos, (uint64_t)header->numEdges, size)) {
+        problem = "graph file is corrupt";
+    }
+
+    CsrGraph* csr = NULL;
+    if (!problem) {
+        csr = (CsrGraph*)malloc(sizeof(CsrGraph));
+        if (!csr) {
+            problem = "memory allocation failed";
+        }
+    }
+    if (csr) {
+        csr->numVertices = header->numVertices;
+        csr->numEdges = header->numEdges;
+        csr->offsets = (int*)(base + header->offsetsPos);
+        csr->targets = (int*)(base + header->targetsPos);
+        csr->weights = (int*)(base + header->weightsPos);
+        csr->mapping = base;
+        csr->mappingSize = size;
+        if (csr->offsets[0] != 0 || csr->offsets[csr->numVertices] != csr->numEdges) {
+            problem = "graph file is corrupt";
+            free(csr);
+            csr = NULL;
+        }
+    }
+    if (problem) {
+        printf("Error: %s: %s\n", path, problem);
+        unmapGraphFile(base, size);
+        return NULL;
+    }
+    return csr;
+}
+
+/**
+ * Full O(V + E) consistency check of a CSR graph: offsets must rise from
+ * 0 to numEdges and every target must be a valid vertex
+ * Returns 0 if the graph is consistent, -1 otherwise
+ */
+int verifyCsrGraph(const CsrGraph* csr) {
+    if (!csr || csr->numVertices <= 0 || csr->numEdges < 0 || csr->offsets[0] != 0 ||
+        csr->offsets[csr->numVertices] != csr->numEdges) {
+        return -1;
+    }
+    for (int v = 0; v < csr->numVertices; v++) {
+        if (csr->offsets[v] > csr->offsets[v + 1]) {
+            return -1;
+        }
+    }
+    for (int e = 0; e < csr->numEdges; e++) {
+        if ((unsigned)csr->targets[e] >= (unsigned)csr->numVertices) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* ====================
+ * TEXT GRAPH LOADERS
+ * ==================== */
+
+// Chunks per thread, so threads that draw dense chunks do not hold up the rest
+#define TEXT_CHUNKS_PER_THREAD 4
+// Smallest chunk worth handing to a thread
+#define TEXT_MIN_CHUNK (64 * 1024)
+// Vertex blocks per thread for the counting sort
+#define TEXT_BLOCKS_PER_THREAD 16
+
+// Weight column of each edge line
+enum { WEIGHT_OPTIONAL, WEIGHT_INT, WEIGHT_REAL, WEIGHT_NONE };
+
+/*What the header of a text file says about its edge lines*/
+typedef struct TextFormat {
+    GraphFormat format;
+    int numVertices;         // Declared vertex count, 0 if the edges decide
+    int base;                // 1 for MatrixMarket and DIMACS ids
+    int weightKind;
+    bool symmetric;          // Each line also stands for the reverse edge
+    char comment;            // Lines starting with this are skipped
+    char altComment;
+} TextFormat;
+
+/*Edges parsed from one newline-aligned slice of the file*/
+typedef struct EdgeChunk {
+    const char* begin;
+    const char* end;
+    int* src;
+    int* dest;
+    int* weight;
+    int size;
+    int capacity;
+    int maxVertex;
+    const char* error;       // Start of the first bad line, NULL if none
+    const char* problem;     // What was wrong with it
+    int* blockPos;           // Edges per vertex block, then scatter positions
+} EdgeChunk;
+
+/*State shared by all threads of one text load*/
+typedef struct TextLoad {
+    const char* fileEnd;
+    TextFormat format;
+    EdgeChunk* chunks;
+    int numChunks;
+    int numVertices;
+    int numBlocks;
+    int blockSize;           // Vertices per block
+    int* blockStart;         // First partitioned edge of each block
+    int* src;                // Edges grouped by block, file order inside
+    int* dest;
+    int* weight;
+    CsrGraph* csr;
+    atomic_bool failed;      // Set if a thread could not allocate
+} TextLoad;
+
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define TEXT_SWAR 1
+/**
+ * Index of the lowest set bit of a non-zero word
+ */
+static int textLowestBit(uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanForward(&index, (unsigned long)word)) {
+        return (int)index;
+    }
+    _BitScanForward(&index, (unsigned long)(word >> 32));
+    return (int)index + 32;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+/**
+ * Reads the leading run of up to 8 digits at p with word arithmetic
+ * p must have 8 readable bytes; *length gets the number of digits
+ */
+static uint64_t parseDigitsSwar(const char* p, int* length) {
+    const uint64_t ones = 0x0101010101010101ULL;
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+
+    // A byte is a digit iff it and the byte plus 6 both have high nibble 3;
+    // carries only reach bytes after the first non-digit
+    uint64_t highs = (word & 0xF0 * ones) ^ 0x30 * ones;
+    uint64_t plusSix = ((word + 0x06 * ones) & 0xF0 * ones) ^ 0x30 * ones;
+    uint64_t nonDigits = highs | plusSix;
+    int digits = nonDigits ? textLowestBit(nonDigits) >> 3 : 8;
+    *length = digits;
+    if (digits == 0) {
+        return 0;
+    }
+
+    // Left-align the digits so the missing leading ones read as zeros,
+    // then combine pairs, quads and the two halves
+    uint64_t value = (word - 0x30 * ones) << (8 * (8 - digits));
+    value = value * 10 + (value >> 8);
+    value = ((value & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) +
+             ((value >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >> 32;
+    return value;
+}
+#endif
+
+static const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    return p;
+}
+
+static const char* skipLine(const char* p, const char* end) {
+    const char* newline = (const char*)memchr(p, '\n', end - p);
+    return newline ? newline + 1 : end;
+}
+
+/**
+ * Parses an optionally signed decimal int at *cursor
+ * Digits are consumed 8 at a time while 8 bytes of the file remain
+ * Returns false if there is no number or it does not fit in an int
+ */
+static bool parseInt(const char** cursor, const char* end, const char* fileEnd, int* out) {
+#ifndef TEXT_SWAR
+    (void)fileEnd;
+#endif
+    const char* p = skipBlanks(*cursor, end);
+    bool negative = p < end && *p == '-';
+    if (negative || (p < end && *p == '+')) {
+        p++;
+    }
+
+    long long value = 0;
+    int total = 0;
+    for (;;) {
+        int length = 0;
+#ifdef TEXT_SWAR
+        if (fileEnd - p >= 8) {
+            uint64_t digits = parseDigitsSwar(p, &length);
+            static const long long scale[9] = {1, 10, 100, 1000, 10000, 100000, 1000000,
+                                               10000000, 100000000};
+            value = value * scale[length] + (long long)digits;
+        } else
+#endif
+        {
+            while (p + length < end && (unsigned)(p[length] - '0') < 10 && length < 8) {
+                value = value * 10 + (p[length] - '0');
+                length++;
+            }
+        }
+        p += length;
+        total += length;
+        if (length < 8 || value > INT_MAX) {
+            break;
+        }
+    }
+
+    if (total == 0 || value > (negative ? (long long)INT_MAX + 1 : INT_MAX)) {
+        return false;
+    }
+    *out = (int)(negative ? -value : value);
+    *cursor = p;
+    return true;
+}
+
+/**
+ * Parses a real number at *cursor and rounds it to the nearest int
+ */
+static bool parseRoundedReal(const char** cursor, const char* end, int* out) {
+    const char* p = skipBlanks(*cursor, end);
+    char token[64];
+    int length = 0;
+    while (p + length < end && length < (int)sizeof(token) - 1 && p[length] != ' ' &&
+           p[length] != '\t' && p[length] != '\r' && p[length] != '\n') {
+        token[length] = p[length];
+        length++;
+    }
+    token[length] = '\0';
+
+    char* parsed;
+    double value = strtod(token, &parsed);
+    if (length == 0 || *parsed != '\0' || !(value > INT_MIN - 0.5 && value < INT_MAX + 0.5)) {
+        return false;
+    }
+    *out = (int)(value < 0 ? value - 0.5 : value + 0.5);
+    *cursor = p + length;
+    return true;
+}
+
+/**
+ * Appends an edge to a chunk, growing its arrays when needed
+ */
+static bool chunkPush(EdgeChunk* chunk, int src, int dest, int weight) {
+    if (chunk->size == chunk->capacity) {
+        if (chunk->capacity > INT_MAX / 2) {
+            return false;
+        }
+        int capacity = chunk->capacity ? 2 * chunk->capacity : 1024;
+        int* grown[3] = {chunk->src, chunk->dest, chunk->weight};
+        for (int i = 0; i < 3; i++) {
+            int* array = (int*)realloc(grown[i], capacity * sizeof(int));
+            if (!array) {
+                chunk->src = grown[0];
+                chunk->dest = grown[1];
+                chunk->weight = grown[2];
+                return false;
+            }
+            grown[i] = array;
+        }
+        chunk->src = grown[0];
+        chunk->dest = grown[1];
+        chunk->weight = grown[2];
+        chunk->capacity = capacity;
+    }
+    chunk->src[chunk->size] = src;
+    chunk->dest[chunk->size] = dest;
+    chunk->weight[chunk->size] = weight;
+    chunk->size++;
+    if (src > chunk->maxVertex) chunk->maxVertex = src;
+    if (dest > chunk->maxVertex) chunk->maxVertex = dest;
+    return true;
+}
+
+/**
+ * Parses every edge line of one chunk
+ * Stops at the first bad line and records it in chunk->error
+ */
+static void parseChunk(TextLoad* load, EdgeChunk* chunk) {
+    const TextFormat* format = &load->format;
+    const char* p = chunk->begin;
+    const char* end = chunk->end;
+
+    while (p < end) {
+        const char* line = p;
+        p = skipBlanks(p, end);
+        if (p == end) {
+            break;
+        }
+        if (*p == '\n' || *p == format->comment || *p == format->altComment) {
+            p = skipLine(p, end);
+            continue;
+        }
+        if (format->format == GRAPH_FORMAT_DIMACS) {
+            if (*p != 'a') {
+                chunk->problem = "expected an 'a' line";
+                chunk->error = line;
+                return;
+            }
+            p++;
+        }
+
+        int src, dest, weight = 1;
+        bool ok = parseInt(&p, end, load->fileEnd, &src) &&
+                  parseInt(&p, end, load->fileEnd, &dest);
+        if (ok) {
+            switch (format->weightKind) {
+            case WEIGHT_INT:
+                ok = parseInt(&p, end, load->fileEnd, &weight);
+                break;
+            case WEIGHT_REAL:
+                ok = parseRoundedReal(&p, end, &weight);
+                break;
+            case WEIGHT_OPTIONAL:
+                p = skipBlanks(p, end);
+                if (p < end && *p != '\n') {
+                    ok = parseInt(&p, end, load->fileEnd, &weight);
+                }
+                break;
+            }
+        }
+        if (!ok) {
+            chunk->problem = "malformed edge";
+            chunk->error = line;
+            return;
+        }
+
+        src -= format->base;
+        dest -= format->base;
+        if (src < 0 || dest < 0 ||
+            (format->numVertices && (src >= format->numVertices || dest >= format->numVertices))) {
+            chunk->problem = "vertex out of range";
+            chunk->error = line;
+            return;
+        }
+        if (!chunkPush(chunk, src, dest, weight) ||
+            (format->symmetric && src != dest && !chunkPush(chunk, dest, src, weight))) {
+            atomic_store(&load->failed, true);
+            return;
+        }
+        // Extra columns, such as timestamps, are ignored
+        p = skipLine(p, end);
+    }
+}
+
+static void textParseTask(void* arg, int index, int numThreads) {
+    TextLoad* load = (TextLoad*)arg;
+    for (int c = index; c < load->numChunks; c += numThreads) {
+        parseChunk(load, &load->chunks[c]);
+    }
+}
+
+/**
+ * Counting sort, pass 1: edges of each chunk per vertex block
+ */
+static void textCountTask(void* arg, int index, int numThreads) {
+    TextLoad* load = (TextLoad*)arg;
+    for (int c = index; c < load->numChunks; c += numThreads) {
+        EdgeChunk* chunk = &load->chunks[c];
+        for (int i = 0; i < chunk->size; i++) {
+            chunk->blockPos[chunk->src[i] / load->blockSize]++;
+        }
+    }
+}
+
+/**
+ * Counting sort, pass 2: every chunk scatters its edges to the slots the
+ * prefix sum reserved for it in each block, keeping file order
+ */
+static void textScatterTask(void* arg, int index, int numThreads) {
+    TextLoad* load = (TextLoad*)arg;
+    for (int c = index; c < load->numChunks; c += numThreads) {
+        EdgeChunk* chunk = &load->chunks[c];
+        for (int i = 0; i < chunk->size; i++) {
+            int pos = chunk->blockPos[chunk->src[i] / load->blockSize]++;
+            load->src[pos] = chunk->src[i];
+            load->dest[pos] = chunk->dest[i];
+            load->weight[pos] = chunk->weight[i];
+        }
+    }
+}
+
+/**
+ * Counting sort, pass 3: each block is sorted by source on its own and
+ * writes the CSR offsets of its vertices
+ * Edges of a vertex are stored last line first, the order addEdge() gives
+ */
+static void textSortTask(void* arg, int index, int numThreads) {
+    TextLoad* load = (TextLoad*)arg;
+    CsrGraph* csr = load->csr;
+    int* fill = NULL;
+    if (index < load->numBlocks) {
+        fill = (int*)malloc(load->blockSize * sizeof(int));
+        if (!fill) {
+            atomic_store(&load->failed, true);
+            return;
+        }
+    }
+
+    for (int b = index; b < load->numBlocks; b += numThreads) {
+        int first = b * load->blockSize;
+        int last = first + load->blockSize < load->numVertices ? first + load->blockSize
+                                                               : load->numVertices;
+        int begin = load->blockStart[b];
+        int end = load->blockStart[b + 1];
+
+        for (int v = first; v < last; v++) {
+            fill[v - first] = 0;
+        }
+        for (int e = begin; e < end; e++) {
+            fill[load->src[e] - first]++;
+        }
+        int running = begin;
+        for (int v = first; v < last; v++) {
+            csr->offsets[v] = running;
+            running += fill[v - first];
+            fill[v - first] = running;
+        }
+        for (int e = begin; e < end; e++) {
+            int pos = --fill[load->src[e] - first];
+            csr->targets[pos] = load->dest[e];
+            csr->weights[pos] = load->weight[e];
+        }
+    }
+    free(fill);
+}
+
+/**
+ * Copies one line of the header into a NUL-terminated buffer
+ * Returns the start of the next line
+ */
+static const char* readHeaderLine(const char* p, const char* end, char* line, int capacity) {
+    const char* next = skipLine(p, end);
+    int length = (int)(next - p) < capacity - 1 ? (int)(next - p) : capacity - 1;
+    memcpy(line, p, length);
+    line[length] = '\0';
+    return next;
+}
+
+/**
+ * Works out the format and reads the header lines
+ * Returns the first edge line, or NULL with *problem set
+ */
+static const char* parseTextHeader(const char* data, const char* end, GraphFormat requested,
+                                   TextFormat* format, const char** problem) {
+    const char* p = data;
+    char line[256];
+
+    if (requested == GRAPH_FORMAT_AUTO) {
+        const char* first = skipBlanks(p, end);
+        while (first < end && *first == '\n') {
+            first = skipBlanks(first + 1, end);
+        }
+        if (end - p >= 14 && memcmp(p, "%%MatrixMarket", 14) == 0) {
+            requested = GRAPH_FORMAT_MATRIX_MARKET;
+        } else if (first + 1 < end && (*first == 'c' || *first == 'p') &&
+                   (first[1] == ' ' || first[1] == '\t' || first[1] == '\r' || first[1] == '\n')) {
+            requested = GRAPH_FORMAT_DIMACS;
+        } else {
+            requested = GRAPH_FORMAT_EDGE_LIST;
+        }
+    }
+
+    memset(format, 0, sizeof(*format));
+    format->format = requested;
+    switch (requested) {
+    case GRAPH_FORMAT_MATRIX_MARKET: {
+        char object[32], layout[32], field[32], symmetry[32];
+        p = readHeaderLine(p, end, line, sizeof(line));
+        // Banner keywords are case-insensitive
+        for (char* c = line; *c; c++) {
+            *c = (char)tolower((unsigned char)*c);
+        }
+        if (sscanf(line, "%%%%matrixmarket %31s %31s %31s %31s",
+                   object, layout, field, symmetry) != 4 ||
+            strcmp(object, "matrix") != 0 || strcmp(layout, "coordinate") != 0) {
+            *problem = "not a coordinate MatrixMarket file";
+            return NULL;
+        }
+        if (strcmp(field, "pattern") == 0) {
+            format->weightKind = WEIGHT_NONE;
+        } else if (strcmp(field, "integer") == 0) {
+            format->weightKind = WEIGHT_INT;
+        } else if (strcmp(field, "real") == 0 || strcmp(field, "double") == 0) {
+            format->weightKind = WEIGHT_REAL;
+        } else {
+            *problem = "unsupported MatrixMarket field";
+            return NULL;
+        }
+        if (strcmp(symmetry, "symmetric") == 0) {
+            format->symmetric = true;
+        } else if (strcmp(symmetry, "general") != 0) {
+            *problem = "unsupported MatrixMarket symmetry";
+            return NULL;
+        }
+
+        // Comments, then "rows columns entries"
+        long long rows, columns, entries;
+        do {
+            p = readHeaderLine(p, end, line, sizeof(line));
+        } while (p < end && (line[0] == '%' || line[strspn(line, " \t\r\n")] == '\0'));
+        if (sscanf(line, "%lld %lld %lld", &rows, &columns, &entries) != 3 ||
+            rows <= 0 || columns <= 0 || rows > INT_MAX || columns > INT_MAX) {
+            *problem = "bad MatrixMarket size line";
+            return NULL;
+        }
+        format->numVertices = (int)(rows > columns ? rows : columns);
+        format->base = 1;
+        format->comment = '%';
+        format->altComment = '%';
+        return p;
+    }
+    case GRAPH_FORMAT_DIMACS: {
+        long long vertices = 0, arcs;
+        char kind[32];
+        while (p < end) {
+            p = readHeaderLine(p, end, line, sizeof(line));
+            if (line[0] == 'p') {
+                if (sscanf(line, "p %31s %lld %lld", kind, &vertices, &arcs) != 3 ||
+                    vertices <= 0 || vertices > INT_MAX) {
+                    *problem = "bad DIMACS problem line";
+                    return NULL;
+                }
+                format->numVertices = (int)vertices;
+                format->base = 1;
+                format->weightKind = WEIGHT_INT;
+                format->comment = 'c';
+                format->altComment = 'c';
+                return p;
+            }
+            if (line[0] != 'c' && line[strspn(line, " \t\r\n")] != '\0') {
+                break;
+            }
+        }
+        *problem = "missing DIMACS problem line";
+        return NULL;
+    }
+    default:
+        format->format = GRAPH_FORMAT_EDGE_LIST;
+        format->weightKind = WEIGHT_OPTIONAL;
+        format->comment = '#';
+        format->altComment = '%';
+        return p;
+    }
+}
+
+/**
+ * Frees the per-chunk and partition buffers of a load
+ */
+static void freeTextLoad(TextLoad* load) {
+    for (int c = 0; c < load->numChunks; c++) {
+        free(load->chunks[c].src);
+        free(load->chunks[c].dest);
+        free(load->chunks[c].weight);
+        free(load->chunks[c].blockPos);
+    }
+    free(load->chunks);
+    free(load->blockStart);
+    free(load->src);
+    free(load->dest);
+    free(load->weight);
+}
+
+/**
+ * Loads a text edge list, MatrixMarket or DIMACS file into a CSR graph
+ * The file is memory-mapped and cut into newline-aligned chunks that the
+ * pool's threads parse in parallel; a parallel counting sort by source
+ * then builds the CSR arrays, so no edge goes through addEdge()
+ * Edge lists use 0-based ids and an optional weight (default 1), and the
+ * highest id decides the vertex count; '#' and '%' lines are comments.
+ * Each vertex's edges come out in the order addEdge() would give them.
+ * pool may be NULL to parse on the calling thread
+ */
+CsrGraph* loadCsrGraphText(const char* path, GraphFormat format, ThreadPool* pool) {
+    if (!path) {
+        printf("Error: Path is NULL\n");
+        return NULL;
+    }
+
+    size_t size = 0;
+    const char* data = (const char*)mapGraphFile(path, 1, &size);
+    if (!data) {
+        printf("Error: Cannot map graph file %s\n", path);
+        return NULL;
+    }
+    const char* end = data + size;
+
+    TextLoad load;
+    memset(&load, 0, sizeof(load));
+    atomic_init(&load.failed, false);
+    load.fileEnd = end;
+    const char* problem = NULL;
+    const char* errorLine = NULL;
+    const char* body = parseTextHeader(data, end, format, &load.format, &problem);
+    int numThreads = threadPoolSize(pool);
+
+    // Newline-aligned chunks, a few per thread
+    if (body) {
+        size_t bodySize = (size_t)(end - body);
+        size_t chunks = bodySize / TEXT_MIN_CHUNK;
+        if (chunks > (size_t)numThreads * TEXT_CHUNKS_PER_THREAD) {
+            chunks = (size_t)numThreads * TEXT_CHUNKS_PER_THREAD;
+        }
+        load.numChunks = chunks ? (int)chunks : 1;
+        load.chunks = (EdgeChunk*)calloc(load.numChunks, sizeof(EdgeChunk));
+        if (!load.chunks) {
+            problem = "memory allocation failed";
+        } else {
+            const char* cut = body;
+            for (int c = 0; c < load.numChunks; c++) {
+                const char* target = body + bodySize * (c + 1) / load.numChunks;
+                if (target > cut && target < end && target[-1] != '\n') {
+                    target = skipLine(target, end);
+                }
+                load.chunks[c].begin = cut;
+                load.chunks[c].end = target > cut ? target : cut;
+                load.chunks[c].maxVertex = -1;
+                cut = load.chunks[c].end;
+            }
+            threadPoolRun(pool, textParseTask, &load);
+        }
+    }
+
+    // The first bad line in file order is the one reported
+    long long numEdges = 0;
+    int maxVertex = -1;
+    for (int c = 0; !problem && c < load.numChunks; c++) {
+        if (load.chunks[c].error) {
+            problem = load.chunks[c].problem;
+            errorLine = load.chunks[c].error;
+        }
+        numEdges += load.chunks[c].size;
+        if (load.chunks[c].maxVertex > maxVertex) {
+            maxVertex = load.chunks[c].maxVertex;
+        }
+    }
+    if (!problem && atomic_load(&load.failed)) {
+        problem = "memory allocation failed";
+    }
+    if (!problem && numEdges > INT_MAX) {
+        problem = "too many edges";
+    }
+    load.numVertices = load.format.numVertices ? load.format.numVertices : maxVertex + 1;
+    if (!problem && load.numVertices <= 0) {
+        problem = "no edges";
+    }
+
+    // Partition the edges into vertex blocks, one counting sort per block
+    if (!problem) {
+        load.numBlocks = numThreads * TEXT_BLOCKS_PER_THREAD;
+        if (load.numBlocks > load.numVertices) {
+            load.numBlocks = load.numVertices;
+        }
+        load.blockSize = (int)(((long long)load.numVertices + load.numBlocks - 1) / load.numBlocks);
+        load.numBlocks = (int)(((long long)load.numVertices + load.blockSize - 1) / load.blockSize);
+        size_t slots = numEdges ? (size_t)numEdges : 1;
+        load.blockStart = (int*)malloc((load.numBlocks + 1) * sizeof(int));
+        load.src = (int*)malloc(slots * sizeof(int));
+        load.dest = (int*)malloc(slots * sizeof(int));
+        load.weight = (int*)malloc(slots * sizeof(int));
+        bool ok = load.blockStart && load.src && load.dest && load.weight;
+        for (int c = 0; ok && c < load.numChunks; c++) {
+            load.chunks[c].blockPos = (int*)calloc(load.numBlocks, sizeof(int));
+            ok = load.chunks[c].blockPos != NULL;
+        }
+
+        CsrGraph* csr = ok ? (CsrGraph*)malloc(sizeof(CsrGraph)) : NULL;
+        if (csr) {
+            csr->numVertices = load.numVertices;
+            csr->numEdges = (int)numEdges;
+            csr->mapping = NULL;
+            csr->mappingSize = 0;
+            csr->offsets = (int*)malloc(((size_t)load.numVertices + 1) * sizeof(int));
+            csr->targets = (int*)malloc(slots * sizeof(int));
+            csr->weights = (int*)malloc(slots * sizeof(int));
+            load.csr = csr;
+            if (!csr->offsets || !csr->targets || !csr->weights) {
+                csr = NULL;
+            }
+        }
+
+        if (!csr) {
+            problem = "memory allocation failed";
+        } else {
+            threadPoolRun(pool, textCountTask, &load);
+            // Block-major prefix sum: block b, then chunk c within it
+            int running = 0;
+            for (int b = 0; b < load.numBlocks; b++) {
+                load.blockStart[b] = running;
+                for (int c = 0; c < load.numChunks; c++) {
+                    int count = load.chunks[c].blockPos[b];
+                    load.chunks[c].blockPos[b] = running;
+                    running += count;
+                }
+            }
+            load.blockStart[load.numBlocks] = running;
+            csr->offsets[load.numVertices] = running;
+
+            threadPoolRun(pool, textScatterTask, &load);
+            threadPoolRun(pool, textSortTask, &load);
+            if (atomic_load(&load.failed)) {
+                problem = "memory allocation failed";
+            }
+        }
+    }
+
+    CsrGraph* csr = load.csr;
+    freeTextLoad(&load);
+    if (problem) {
+        freeCsrGraph(csr);
+        if (errorLine) {
+            long long lineNumber = 1;
+            for (const char* q = data; (q = (const char*)memchr(q, '\n', errorLine - q)); q++) {
+                lineNumber++;
+            }
+            printf("Error: %s:%lld: %s\n", path, lineNumber, problem);
+        } else {
+            printf("Error: %s: %s\n", path, problem);
+        }
+        csr = NULL;
+    }
+    unmapGraphFile((void*)data, size);
+    return csr;
+}
+
+/**
+ * Loads a text graph file into adjacency lists, see loadCsrGraphText()
+ * The nodes are carved from the graph's pool in one run, and each list
+ * matches what calling addEdge() for every line would have built
+ */
+Graph* loadGraphText(const char* path, GraphFormat format, ThreadPool* pool) {
+    CsrGraph* csr = loadCsrGraphText(path, format, pool);
+    if (!csr) {
+        return NULL;
+    }
+
+    Graph* graph = createGraph(csr->numVertices);
+    char* block = NULL;
+    if (graph && csr->numEdges > 0) {
+        block = (char*)poolAllocMany(graph->nodePool, csr->numEdges);
+        if (!block) {
+            printf("Error: Memory allocation failed for graph nodes\n");
+            freeGraph(graph);
+            graph = NULL;
+        }
+    }
+
+    if (graph && block) {
+        size_t stride = graph->nodePool->objectSize;
+        for (int v = 0; v < csr->numVertices; v++) {
+            Node* head = NULL;
+            for (int e = csr->offsets[v + 1] - 1; e >= csr->offsets[v]; e--) {
+                Node* node = (Node*)(block + (size_t)e * stride);
+                node->vertex = csr->targets[e];
+                node->weight = csr->weights[e];
+                node->next = head;
+                head = node;
+            }
+            graph->adjLists[v] = head;
+        }
+    }
+    freeCsrGraph(csr);
+    return graph;
+}
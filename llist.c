@@ -1,22 +1,61 @@
 #include "dshelp.h" // Changed from llist.h
+#ifdef _WIN32
+#include <malloc.h>
+#endif
 list* llist_insert(list *head)
 {
     int x;
     printf("Enter the Value to be Inserted: ");
     scanf("%d", &x);
     
-    list* ptr = (list*)malloc(sizeof(list));
-    if (ptr != NULL) 
+    return llist_push(head, x);
+}
+list* llist_push(list *head, int x)
+{
+    return llist_pool_push(NULL, head, x);
+}
+static list* llist_pushManyWith(NodePool *pool, list *head, const int *values, size_t count)
+{
+    if (count == 0)
+        return head;
+    // With a pool the whole chain is one contiguous run of nodes
+    char* block = pool ? (char*)poolAllocMany(pool, count) : NULL;
+    if (pool && block == NULL)
     {
-        ptr->data = x;
-        ptr->next = head;
-        head = ptr;
-    } else {
         printf("Node Creation Failed\n");
+        return head;
     }
-    return head;
+    list* top = head;
+    for (size_t i = 0; i < count; i++) 
+    {
+        list* ptr = block ? (list*)(block + i * pool->objectSize) : (list*)malloc(sizeof(list));
+        if (ptr == NULL) 
+        {
+            // All or nothing: drop the nodes pushed so far
+            while (top != head)
+            {
+                list* next = top->next;
+                free(top);
+                top = next;
+            }
+            printf("Node Creation Failed\n");
+            return head;
+        }
+        ptr->data = values[i];
+        ptr->next = top;
+        top = ptr;
+    }
+    return top;
 }
-list* llist_deleteAtLeft(list *head) 
+list* llist_push_many(list *head, const int *values, size_t count)
+{
+    return llist_pushManyWith(NULL, head, values, count);
+}
+list* llist_pool_push_many(NodePool *pool, list *head, const int *values, size_t count)
+{
+    return llist_pushManyWith(pool, head, values, count);
+}
+static list* llist_deleteAtLeftWith(NodePool* pool, list *head) 
 {
     if (head == NULL) 
     {
@@ -27,12 +66,12 @@ list* llist_deleteAtLeft(list *head)
     list* ptr = head;
     int x = ptr->data;
     head = ptr->next;
-    free(ptr);
+    poolFree(pool, ptr);
 
     printf("Value %d has been Deleted\n", x);
     return head;
 }
-list* llist_deleteLast(list *head) 
+static list* llist_deleteLastWith(NodePool* pool, list *head) 
 {
     if (head == NULL) 
     {
@@ -42,7 +81,7 @@ list* llist_deleteLast(list *head)
     if (head->next == NULL) 
     {
         printf("Value %d has been Deleted\n", head->data);
-        free(head);
+        poolFree(pool, head);
         return NULL;
     }
     list* ptr1 = head;
@@ -53,25 +92,57 @@ list* llist_deleteLast(list *head)
         ptr2 = ptr2->next;
     }
     printf("Value %d has been Deleted\n", ptr2->data);
-    free(ptr2);
+    poolFree(pool, ptr2);
     ptr1->next = NULL;
     return head;
 }
-void llist_search(list *head , int key) 
+list* llist_deleteAtLeft(list *head) 
 {
-    int found = 0;
-
-    while (head != NULL) 
+    return llist_deleteAtLeftWith(NULL, head);
+}
+list* llist_deleteLast(list *head) 
+{
+    return llist_deleteLastWith(NULL, head);
+}
+list* llist_pool_push(NodePool *pool, list *head, int x)
+{
+    list* ptr = (list*)poolAlloc(pool, sizeof(list));
+    if (ptr != NULL) 
     {
-        if (head->data == key) 
-        {
-            found = 1;
-            break;
-        }
-        head = head->next;
+        ptr->data = x;
+        ptr->next = head;
+        head = ptr;
+    } else {
+        printf("Node Creation Failed\n");
     }
-
-    if (found)
+    return head;
+}
+list* llist_pool_deleteAtLeft(NodePool *pool, list *head) 
+{
+    return llist_deleteAtLeftWith(pool, head);
+}
+list* llist_pool_deleteLast(NodePool *pool, list *head) 
+{
+    return llist_deleteLastWith(pool, head);
+}
+list* llist_clear(list *head) 
+{
+    while (head != NULL) {
+        list* next = head->next;
+        free(head);
+        head = next;
+    }
+    return NULL;
+}
+list* llist_find(list *head, int key) 
+{
+    while (head != NULL && head->data != key)
+        head = head->next;
+    return head;
+}
+void llist_search(list *head , int key) 
+{
+    if (llist_find(head, key) != NULL)
         printf("Value Successfully Found\n");
     else
         printf("Value NOT Found\n");
@@ -89,6 +160,17 @@ void llist_display(list *head)
     }
     printf("\n");
 }
+int llist_store(list *head, int *out, int capacity) 
+{
+    int c = 0;
+    while (head != NULL) {
+        if (c < capacity)
+            out[c] = head->data;
+        c++;
+        head = head->next;
+    }
+    return c;
+}
 int llist_count(list *head) 
 {
     int c = 0;
@@ -106,4 +188,305 @@ void llist_Rdisplay(list *head)
         printf("%d  ", temp);
     }
     printf("\n");
+}
+ListHeader* llist_createHeader(NodePool *pool)
+{
+    ListHeader* list = (ListHeader*)malloc(sizeof(ListHeader));
+    if (list == NULL) 
+    {
+        printf("Header Creation Failed\n");
+        return NULL;
+    }
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->pool = pool;
+    return list;
+}
+static dlist* llist_header_node(ListHeader *list, int x)
+{
+    dlist* ptr = (dlist*)poolAlloc(list->pool, sizeof(dlist));
+    if (ptr == NULL) 
+    {
+        printf("Node Creation Failed\n");
+        return NULL;
+    }
+    ptr->data = x;
+    ptr->prev = NULL;
+    ptr->next = NULL;
+    return ptr;
+}
+void llist_header_push(ListHeader *list, int x)
+{
+    dlist* ptr = llist_header_node(list, x);
+    if (ptr == NULL)
+        return;
+    ptr->next = list->head;
+    if (list->head != NULL)
+        list->head->prev = ptr;
+    else
+        list->tail = ptr;
+    list->head = ptr;
+    list->size++;
+}
+void llist_header_append(ListHeader *list, int x)
+{
+    dlist* ptr = llist_header_node(list, x);
+    if (ptr == NULL)
+        return;
+    ptr->prev = list->tail;
+    if (list->tail != NULL)
+        list->tail->next = ptr;
+    else
+        list->head = ptr;
+    list->tail = ptr;
+    list->size++;
+}
+int llist_header_popFront(ListHeader *list, int *out)
+{
+    dlist* ptr = list->head;
+    if (ptr == NULL)
+        return -1;
+    list->head = ptr->next;
+    if (list->head != NULL)
+        list->head->prev = NULL;
+    else
+        list->tail = NULL;
+    list->size--;
+    if (out != NULL)
+        *out = ptr->data;
+    poolFree(list->pool, ptr);
+    return 0;
+}
+int llist_header_popBack(ListHeader *list, int *out)
+{
+    dlist* ptr = list->tail;
+    if (ptr == NULL)
+        return -1;
+    list->tail = ptr->prev;
+    if (list->tail != NULL)
+        list->tail->next = NULL;
+    else
+        list->head = NULL;
+    list->size--;
+    if (out != NULL)
+        *out = ptr->data;
+    poolFree(list->pool, ptr);
+    return 0;
+}
+void llist_header_deleteAtLeft(ListHeader *list)
+{
+    int x;
+    if (llist_header_popFront(list, &x) != 0) 
+    {
+        printf("Linked List is Empty\n");
+        return;
+    }
+    printf("Value %d has been Deleted\n", x);
+}
+void llist_header_deleteLast(ListHeader *list)
+{
+    int x;
+    if (llist_header_popBack(list, &x) != 0) 
+    {
+        printf("Linked List is Empty\n");
+        return;
+    }
+    printf("Value %d has been Deleted\n", x);
+}
+int llist_header_count(ListHeader *list)
+{
+    return list->size;
+}
+void llist_header_display(ListHeader *list)
+{
+    if (list->head == NULL) {
+        printf("Linked List is Empty\n");
+        return;
+    }
+
+    for (dlist* ptr = list->head; ptr != NULL; ptr = ptr->next) {
+        printf("%d\n", ptr->data);
+    }
+    printf("\n");
+}
+int llist_header_store(ListHeader *list, int *out, int capacity)
+{
+    int c = 0;
+    for (dlist* ptr = list->head; ptr != NULL && c < capacity; ptr = ptr->next) {
+        out[c++] = ptr->data;
+    }
+    return list->size;
+}
+void llist_header_clear(ListHeader *list)
+{
+    while (list->head != NULL) {
+        dlist* next = list->head->next;
+        poolFree(list->pool, list->head);
+        list->head = next;
+    }
+    list->tail = NULL;
+    list->size = 0;
+}
+void llist_freeHeader(ListHeader *list)
+{
+    if (list == NULL)
+        return;
+    llist_header_clear(list);
+    free(list);
+}
+// Blocks start on a cache line, so each one is a single line fetch
+#define ULIST_ALIGN 64
+static ulist* ulist_allocBlock(void)
+{
+#ifdef _WIN32
+    return (ulist*)_aligned_malloc(sizeof(ulist), ULIST_ALIGN);
+#else
+    // aligned_alloc wants the size to be a multiple of the alignment
+    return (ulist*)aligned_alloc(ULIST_ALIGN, (sizeof(ulist) + ULIST_ALIGN - 1) & ~(size_t)(ULIST_ALIGN - 1));
+#endif
+}
+static void ulist_freeBlock(ulist *block)
+{
+#ifdef _WIN32
+    _aligned_free(block);
+#else
+    free(block);
+#endif
+}
+ulist* ulist_push(ulist *head, int x)
+{
+    if (head == NULL || head->count == (int)ULIST_BLOCK_INTS) 
+    {
+        ulist* ptr = ulist_allocBlock();
+        if (ptr == NULL) 
+        {
+            printf("Node Creation Failed\n");
+            return head;
+        }
+        ptr->next = head;
+        ptr->count = 0;
+        head = ptr;
+    }
+    head->data[head->count++] = x;
+    return head;
+}
+ulist* ulist_push_many(ulist *head, const int *values, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        head = ulist_push(head, values[i]);
+    return head;
+}
+ulist* ulist_deleteAtLeft(ulist *head)
+{
+    if (head == NULL) 
+    {
+        printf("Linked List is Empty\n");
+        return head;
+    }
+
+    int x = head->data[--head->count];
+    if (head->count == 0) 
+    {
+        ulist* next = head->next;
+        ulist_freeBlock(head);
+        head = next;
+    }
+
+    printf("Value %d has been Deleted\n", x);
+    return head;
+}
+ulist* ulist_deleteLast(ulist *head)
+{
+    if (head == NULL) 
+    {
+        printf("Linked List is Empty\n");
+        return head;
+    }
+    ulist* prev = NULL;
+    ulist* ptr = head;
+    while (ptr->next != NULL) 
+    {
+        prev = ptr;
+        ptr = ptr->next;
+    }
+    // The last value sits at data[0] of the last block
+    printf("Value %d has been Deleted\n", ptr->data[0]);
+    ptr->count--;
+    for (int i = 0; i < ptr->count; i++)
+        ptr->data[i] = ptr->data[i + 1];
+    if (ptr->count == 0) 
+    {
+        ulist_freeBlock(ptr);
+        if (prev == NULL)
+            return NULL;
+        prev->next = NULL;
+    }
+    return head;
+}
+int ulist_indexOf(ulist *head, int key)
+{
+    int position = 0;
+    while (head != NULL) 
+    {
+        // Blocks are stored back to front, so the first match is the last slot
+        int i = searchIntsLast(head->data, head->count, key);
+        if (i >= 0)
+            return position + head->count - 1 - i;
+        position += head->count;
+        head = head->next;
+    }
+    return -1;
+}
+void ulist_search(ulist *head, int key)
+{
+    if (ulist_indexOf(head, key) >= 0)
+        printf("Value Successfully Found\n");
+    else
+        printf("Value NOT Found\n");
+}
+void ulist_display(ulist *head)
+{
+    if (head == NULL) {
+        printf("Linked List is Empty\n");
+        return;
+    }
+
+    while (head != NULL) {
+        for (int i = head->count - 1; i >= 0; i--)
+            printf("%d\n", head->data[i]);
+        head = head->next;
+    }
+    printf("\n");
+}
+int ulist_store(ulist *head, int *out, int capacity)
+{
+    int c = 0;
+    while (head != NULL) {
+        for (int i = head->count - 1; i >= 0; i--) {
+            if (c < capacity)
+                out[c] = head->data[i];
+            c++;
+        }
+        head = head->next;
+    }
+    return c;
+}
+int ulist_count(ulist *head)
+{
+    int c = 0;
+    while (head != NULL) {
+        c += head->count;
+        head = head->next;
+    }
+    return c;
+}
+ulist* ulist_clear(ulist *head)
+{
+    while (head != NULL) {
+        ulist* next = head->next;
+        ulist_freeBlock(head);
+        head = next;
+    }
+    return NULL;
 }
\ No newline at end of file
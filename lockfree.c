@@ -0,0 +1,880 @@
+#include "dshelp.h"
+#include <pthread.h>
+#include <stdatomic.h>
+/* ====================
+ * HAZARD POINTERS
+ * ==================== */
+
+// Hazard slots per thread; the queue dequeue needs two
+#define HAZARDS_PER_THREAD 2
+
+/*Node unlinked by a concurrent BST writer, freed two epochs later*/
+typedef struct EpochRetired {
+    void* node;
+    unsigned long epoch;             // Global epoch when it was unlinked
+} EpochRetired;
+
+/*Per-thread hazard slots plus the nodes that thread has retired*/
+typedef struct HazardRecord {
+    _Atomic(void*) hazards[HAZARDS_PER_THREAD];
+    atomic_bool active;              // Owned by a live thread
+    struct HazardRecord* next;       // Records are never unlinked
+    void** retired;                  // Unlinked nodes waiting to be freed
+    int numRetired;
+    int retiredCapacity;
+    atomic_ulong epoch;              // Epoch of the current read, 0 when idle
+    EpochRetired* epochRetired;      // Nodes retired under epoch reclamation
+    int numEpochRetired;
+    int epochRetiredCapacity;
+} HazardRecord;
+
+/*Epoch retire list left behind by an exited thread*/
+typedef struct OrphanedRetired {
+    EpochRetired* nodes;
+    int numNodes;
+    struct OrphanedRetired* next;
+} OrphanedRetired;
+
+static _Atomic(HazardRecord*) hazardRecords = NULL;
+static atomic_int hazardRecordCount = 0;
+static atomic_ulong globalEpoch = 1;
+static _Atomic(OrphanedRetired*) orphanedRetired = NULL;
+static pthread_key_t hazardKey;
+static pthread_once_t hazardKeyOnce = PTHREAD_ONCE_INIT;
+
+static void hazardScan(HazardRecord* record);
+static void epochReclaim(HazardRecord* record);
+static void epochOrphan(HazardRecord* record);
+
+/**
+ * Thread exit: drop the hazards and hand the record to the next thread
+ * Nodes still protected elsewhere stay on its retired list; epoch-retired
+ * nodes move to the global orphan list so any thread can free them
+ */
+static void releaseHazardRecord(void* param) {
+    HazardRecord* record = (HazardRecord*)param;
+    for (int i = 0; i < HAZARDS_PER_THREAD; i++) {
+        atomic_store(&record->hazards[i], NULL);
+    }
+    atomic_store(&record->epoch, 0);
+    hazardScan(record);
+    if (record->numEpochRetired > 0) {
+        epochReclaim(record);
+        epochOrphan(record);
+    }
+    atomic_store(&record->active, false);
+}
+
+static void createHazardKey(void) {
+    pthread_key_create(&hazardKey, releaseHazardRecord);
+}
+
+/**
+ * Hazard record of the calling thread
+ * Reuses the record of an exited thread before allocating a new one
+ * Returns NULL if allocation fails
+ */
+static HazardRecord* hazardRecord(void) {
+    pthread_once(&hazardKeyOnce, createHazardKey);
+    HazardRecord* record = (HazardRecord*)pthread_getspecific(hazardKey);
+    if (record) {
+        return record;
+    }
+
+    for (record = atomic_load(&hazardRecords); record; record = record->next) {
+        bool expected = false;
+        if (!atomic_load(&record->active) &&
+            atomic_compare_exchange_strong(&record->active, &expected, true)) {
+            break;
+        }
+    }
+
+    if (!record) {
+        record = (HazardRecord*)malloc(sizeof(HazardRecord));
+        if (!record) {
+            return NULL;
+        }
+        for (int i = 0; i < HAZARDS_PER_THREAD; i++) {
+            atomic_init(&record->hazards[i], NULL);
+        }
+        atomic_init(&record->active, true);
+        record->retired = NULL;
+        record->numRetired = 0;
+        record->retiredCapacity = 0;
+        atomic_init(&record->epoch, 0);
+        record->epochRetired = NULL;
+        record->numEpochRetired = 0;
+        record->epochRetiredCapacity = 0;
+
+        HazardRecord* head = atomic_load(&hazardRecords);
+        do {
+            record->next = head;
+        } while (!atomic_compare_exchange_weak(&hazardRecords, &head, record));
+        atomic_fetch_add(&hazardRecordCount, 1);
+    }
+
+    pthread_setspecific(hazardKey, record);
+    return record;
+}
+
+/**
+ * Publishes node in a hazard slot and checks that src still points to it
+ * A node seen in any slot is never freed by hazardScan()
+ */
+static void* hazardProtect(HazardRecord* record, int slot, _Atomic(void*)* src) {
+    void* node = atomic_load(src);
+    for (;;) {
+        atomic_store(&record->hazards[slot], node);
+        void* again = atomic_load(src);
+        if (again == node) {
+            return node;
+        }
+        node = again;
+    }
+}
+
+static void hazardClear(HazardRecord* record) {
+    for (int i = 0; i < HAZARDS_PER_THREAD; i++) {
+        atomic_store_explicit(&record->hazards[i], NULL, memory_order_release);
+    }
+}
+
+/**
+ * Frees every retired node that no thread currently protects
+ */
+static void hazardScan(HazardRecord* record) {
+    if (record->numRetired == 0) {
+        return;
+    }
+
+    // Snapshot every published hazard; the array grows with the records seen
+    int capacity = 4 * HAZARDS_PER_THREAD;
+    int numProtected = 0;
+    void** protectedNodes = (void**)malloc(capacity * sizeof(void*));
+    if (!protectedNodes) {
+        return;
+    }
+    for (HazardRecord* other = atomic_load(&hazardRecords); other; other = other->next) {
+        if (numProtected + HAZARDS_PER_THREAD > capacity) {
+            void** grown = (void**)realloc(protectedNodes, 2 * capacity * sizeof(void*));
+            if (!grown) {
+                free(protectedNodes);
+                return;
+            }
+            protectedNodes = grown;
+            capacity *= 2;
+        }
+        for (int i = 0; i < HAZARDS_PER_THREAD; i++) {
+            void* hazard = atomic_load(&other->hazards[i]);
+            if (hazard) {
+                protectedNodes[numProtected++] = hazard;
+            }
+        }
+    }
+
+    int kept = 0;
+    for (int r = 0; r < record->numRetired; r++) {
+        void* node = record->retired[r];
+        bool inUse = false;
+        for (int i = 0; i < numProtected && !inUse; i++) {
+            inUse = protectedNodes[i] == node;
+        }
+        if (inUse) {
+            record->retired[kept++] = node;
+        } else {
+            free(node);
+        }
+    }
+    record->numRetired = kept;
+    free(protectedNodes);
+}
+
+/**
+ * Hands an unlinked node to the reclaimer
+ * Scans once the retired list outgrows twice the number of hazard slots
+ */
+static void hazardRetire(HazardRecord* record, void* node) {
+    if (record->numRetired == record->retiredCapacity) {
+        int capacity = record->retiredCapacity ? record->retiredCapacity * 2 : 64;
+        void** retired = (void**)realloc(record->retired, capacity * sizeof(void*));
+        if (!retired) {
+            // Out of memory: free what we can and, failing that, leak the node
+            hazardScan(record);
+            if (record->numRetired == record->retiredCapacity) {
+                return;
+            }
+        } else {
+            record->retired = retired;
+            record->retiredCapacity = capacity;
+        }
+    }
+    record->retired[record->numRetired++] = node;
+
+    if (record->numRetired >= 2 * HAZARDS_PER_THREAD * atomic_load(&hazardRecordCount) + 32) {
+        hazardScan(record);
+    }
+}
+
+/* ====================
+ * EPOCH RECLAMATION
+ * ==================== */
+
+// Retired nodes per thread before it tries to advance the epoch
+#define EPOCH_RECLAIM_THRESHOLD 64
+
+/**
+ * Marks the start of a read; nodes reachable now stay allocated until
+ * the matching epochExit()
+ */
+static void epochEnter(HazardRecord* record) {
+    atomic_store(&record->epoch, atomic_load(&globalEpoch));
+    // The announcement must be visible before any node pointer is read
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+static void epochExit(HazardRecord* record) {
+    atomic_store_explicit(&record->epoch, 0, memory_order_release);
+}
+
+/**
+ * Frees the nodes retired at least two epochs before epoch and packs
+ * the rest to the front; returns how many are left
+ */
+static int epochFree(EpochRetired* retired, int count, unsigned long epoch) {
+    // A reader that could still see a node retired at epoch e has
+    // announced at most e, which stops the epoch from reaching e + 2
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (retired[i].epoch + 2 <= epoch) {
+            free(retired[i].node);
+        } else {
+            retired[kept++] = retired[i];
+        }
+    }
+    return kept;
+}
+
+/**
+ * Advances the global epoch once every active reader has seen it,
+ * then frees the nodes retired at least two epochs ago, including
+ * those left by exited threads
+ */
+static void epochReclaim(HazardRecord* record) {
+    atomic_thread_fence(memory_order_seq_cst);
+    unsigned long epoch = atomic_load(&globalEpoch);
+    bool quiescent = true;
+    for (HazardRecord* other = atomic_load(&hazardRecords); other; other = other->next) {
+        unsigned long seen = atomic_load(&other->epoch);
+        if (seen != 0 && seen != epoch) {
+            quiescent = false;
+            break;
+        }
+    }
+    if (quiescent && atomic_compare_exchange_strong(&globalEpoch, &epoch, epoch + 1)) {
+        epoch++;
+    }
+
+    record->numEpochRetired = epochFree(record->epochRetired, record->numEpochRetired, epoch);
+
+    if (atomic_load_explicit(&orphanedRetired, memory_order_relaxed)) {
+        // Take the whole list so no other thread walks it, then put back
+        // the batches that still hold nodes
+        OrphanedRetired* batch = atomic_exchange(&orphanedRetired, NULL);
+        while (batch) {
+            OrphanedRetired* next = batch->next;
+            batch->numNodes = epochFree(batch->nodes, batch->numNodes, epoch);
+            if (batch->numNodes == 0) {
+                free(batch->nodes);
+                free(batch);
+            } else {
+                OrphanedRetired* head = atomic_load(&orphanedRetired);
+                do {
+                    batch->next = head;
+                } while (!atomic_compare_exchange_weak(&orphanedRetired, &head, batch));
+            }
+            batch = next;
+        }
+    }
+}
+
+/**
+ * Moves the record's epoch-retired nodes to the global orphan list
+ * Keeps them on the record, for the next thread that takes it, if the
+ * list entry cannot be allocated
+ */
+static void epochOrphan(HazardRecord* record) {
+    if (record->numEpochRetired == 0) {
+        return;
+    }
+    OrphanedRetired* batch = (OrphanedRetired*)malloc(sizeof(OrphanedRetired));
+    if (!batch) {
+        return;
+    }
+    batch->nodes = record->epochRetired;
+    batch->numNodes = record->numEpochRetired;
+    record->epochRetired = NULL;
+    record->numEpochRetired = 0;
+    record->epochRetiredCapacity = 0;
+
+    OrphanedRetired* head = atomic_load(&orphanedRetired);
+    do {
+        batch->next = head;
+    } while (!atomic_compare_exchange_weak(&orphanedRetired, &head, batch));
+}
+
+/**
+ * Hands a node that readers may still be traversing to the reclaimer
+ */
+static void epochRetire(HazardRecord* record, void* node) {
+    if (record->numEpochRetired == record->epochRetiredCapacity) {
+        int capacity = record->epochRetiredCapacity ? record->epochRetiredCapacity * 2
+                                                    : 2 * EPOCH_RECLAIM_THRESHOLD;
+        EpochRetired* retired = (EpochRetired*)realloc(record->epochRetired,
+                                                       capacity * sizeof(EpochRetired));
+        if (!retired) {
+            // Out of memory: free what we can and, failing that, leak the node
+            epochReclaim(record);
+            if (record->numEpochRetired == record->epochRetiredCapacity) {
+                return;
+            }
+        } else {
+            record->epochRetired = retired;
+            record->epochRetiredCapacity = capacity;
+        }
+    }
+    // Pairs with the fence in epochEnter(): a reader that still saw node
+    // announced its epoch before the one read here
+    atomic_thread_fence(memory_order_seq_cst);
+    record->epochRetired[record->numEpochRetired].node = node;
+    record->epochRetired[record->numEpochRetired].epoch = atomic_load(&globalEpoch);
+    record->numEpochRetired++;
+
+    if (record->numEpochRetired >= EPOCH_RECLAIM_THRESHOLD) {
+        epochReclaim(record);
+    }
+}
+
+/* ====================
+ * TREIBER STACK
+ * ==================== */
+
+/*Lock-free stack of list nodes; push and pop work at the head*/
+struct LockFreeStack {
+    _Atomic(void*) head;     // Top list node, NULL when empty
+};
+
+/**
+ * Creates an empty lock-free stack
+ */
+LockFreeStack* createLockFreeStack(void) {
+    LockFreeStack* stack = (LockFreeStack*)malloc(sizeof(LockFreeStack));
+    if (!stack) {
+        printf("Error: Memory allocation failed for lock-free stack\n");
+        return NULL;
+    }
+    atomic_init(&stack->head, NULL);
+    return stack;
+}
+
+/**
+ * Pushes x from any thread, like llist_push() on a shared head
+ * Returns 0, or -1 if allocation fails
+ */
+int lockFreePush(LockFreeStack* stack, int x) {
+    list* node = (list*)malloc(sizeof(list));
+    if (!node) {
+        return -1;
+    }
+    node->data = x;
+    node->next = (list*)atomic_load_explicit(&stack->head, memory_order_relaxed);
+    void* expected = node->next;
+    // A list node's next never changes once it is on the stack
+    while (!atomic_compare_exchange_weak_explicit(&stack->head, &expected, node,
+                                                  memory_order_release, memory_order_relaxed)) {
+        node->next = (list*)expected;
+    }
+    return 0;
+}
+
+/**
+ * Pops the top value into out from any thread
+ * Returns 0, or -1 if the stack is empty
+ */
+int lockFreePop(LockFreeStack* stack, int* out) {
+    HazardRecord* record = hazardRecord();
+    if (!record) {
+        return -1;
+    }
+
+    list* top;
+    for (;;) {
+        top = (list*)hazardProtect(record, 0, &stack->head);
+        if (!top) {
+            hazardClear(record);
+            return -1;
+        }
+        void* expected = top;
+        if (atomic_compare_exchange_weak(&stack->head, &expected, top->next)) {
+            break;
+        }
+    }
+    if (out) {
+        *out = top->data;
+    }
+    hazardClear(record);
+    hazardRetire(record, top);
+    return 0;
+}
+
+/**
+ * Frees the stack and its nodes; no other thread may still use it
+ */
+void freeLockFreeStack(LockFreeStack* stack) {
+    if (!stack) {
+        return;
+    }
+    list* node = (list*)atomic_load(&stack->head);
+    while (node) {
+        list* next = node->next;
+        free(node);
+        node = next;
+    }
+    free(stack);
+}
+
+/* ====================
+ * MICHAEL-SCOTT QUEUE
+ * ==================== */
+
+/*Queue node; next is swung with CAS, so unlike list it is atomic*/
+typedef struct QueueNode {
+    int data;
+    _Atomic(void*) next;
+} QueueNode;
+
+/*Lock-free FIFO queue; head always points at a dummy node*/
+struct LockFreeQueue {
+    _Atomic(void*) head;     // Dummy node; the front value is in head->next
+    _Atomic(void*) tail;     // Last node, or lagging one behind it
+};
+
+/**
+ * Creates an empty lock-free queue
+ */
+LockFreeQueue* createLockFreeQueue(void) {
+    LockFreeQueue* queue = (LockFreeQueue*)malloc(sizeof(LockFreeQueue));
+    QueueNode* dummy = (QueueNode*)malloc(sizeof(QueueNode));
+    if (!queue || !dummy) {
+        printf("Error: Memory allocation failed for lock-free queue\n");
+        free(queue);
+        free(dummy);
+        return NULL;
+    }
+    dummy->data = 0;
+    atomic_init(&dummy->next, NULL);
+    atomic_init(&queue->head, dummy);
+    atomic_init(&queue->tail, dummy);
+    return queue;
+}
+
+/**
+ * Appends x at the tail from any thread
+ * Returns 0, or -1 if allocation fails
+ */
+int lockFreeEnqueue(LockFreeQueue* queue, int x) {
+    HazardRecord* record = hazardRecord();
+    QueueNode* node = (QueueNode*)malloc(sizeof(QueueNode));
+    if (!record || !node) {
+        free(node);
+        return -1;
+    }
+    node->data = x;
+    atomic_init(&node->next, NULL);
+
+    for (;;) {
+        QueueNode* tail = (QueueNode*)hazardProtect(record, 0, &queue->tail);
+        void* next = atomic_load(&tail->next);
+        if (tail != atomic_load(&queue->tail)) {
+            continue;
+        }
+        if (next) {
+            // Tail is lagging: help the other enqueuer finish first
+            void* expected = tail;
+            atomic_compare_exchange_strong(&queue->tail, &expected, next);
+            continue;
+        }
+        void* expected = NULL;
+        if (atomic_compare_exchange_weak(&tail->next, &expected, node)) {
+            expected = tail;
+            atomic_compare_exchange_strong(&queue->tail, &expected, node);
+            break;
+        }
+    }
+    hazardClear(record);
+    return 0;
+}
+
+/**
+ * Removes the front value into out from any thread
+ * Returns 0, or -1 if the queue is empty
+ */
+int lockFreeDequeue(LockFreeQueue* queue, int* out) {
+    HazardRecord* record = hazardRecord();
+    if (!record) {
+        return -1;
+    }
+
+    QueueNode* head;
+    for (;;) {
+        head = (QueueNode*)hazardProtect(record, 0, &queue->head);
+        void* tail = atomic_load(&queue->tail);
+        QueueNode* next = (QueueNode*)hazardProtect(record, 1, &head->next);
+        if (head != atomic_load(&queue->head)) {
+            continue;
+        }
+        if (!next) {
+            hazardClear(record);
+            return -1;
+        }
+        if (tail == head) {
+            void* expected = tail;
+            atomic_compare_exchange_strong(&queue->tail, &expected, next);
+            continue;
+        }
+        // Read before the CAS: once head moves, next may be retired too
+        int value = next->data;
+        void* expected = head;
+        if (atomic_compare_exchange_weak(&queue->head, &expected, next)) {
+            if (out) {
+                *out = value;
+            }
+            break;
+        }
+    }
+    hazardClear(record);
+    hazardRetire(record, head);
+    return 0;
+}
+
+/**
+ * Frees the queue and its nodes; no other thread may still use it
+ */
+void freeLockFreeQueue(LockFreeQueue* queue) {
+    if (!queue) {
+        return;
+    }
+    QueueNode* node = (QueueNode*)atomic_load(&queue->head);
+    while (node) {
+        QueueNode* next = (QueueNode*)atomic_load(&node->next);
+        free(node);
+        node = next;
+    }
+    free(queue);
+}
+
+/* ====================
+ * CONCURRENT BST
+ * ==================== */
+
+// Marks kept in the low bits of a child edge; nodes are at least 4-byte aligned
+#define EDGE_FLAG  ((uintptr_t)1)    // The leaf below is being deleted
+#define EDGE_TAG   ((uintptr_t)2)    // Frozen while its parent is unlinked
+#define EDGE_MARKS (EDGE_FLAG | EDGE_TAG)
+
+// Sentinel keys above every int; the nodes holding them are never removed
+#define KEY_INF0 ((long long)INT_MAX + 1)
+#define KEY_INF1 ((long long)INT_MAX + 2)
+#define KEY_INF2 ((long long)INT_MAX + 3)
+
+/*External BST node: keys live in the leaves, internal nodes only route*/
+typedef struct ConcurrentNode {
+    long long key;               // Internal nodes: smaller keys go left
+    _Atomic(uintptr_t) left;     // Child pointer plus EDGE_* marks, 0 in a leaf
+    _Atomic(uintptr_t) right;
+} ConcurrentNode;
+
+/*Lock-free external BST (Natarajan and Mittal): updates CAS single edges*/
+struct ConcurrentTree {
+    ConcurrentNode* root;        // Sentinel INF2; its left child is sentinel INF1
+};
+
+/*Where a key's search path ends, and what a delete on it would unlink*/
+typedef struct SeekRecord {
+    ConcurrentNode* ancestor;    // Deepest node whose edge on the path is untagged
+    ConcurrentNode* successor;   // Its child; successor..parent go in one CAS
+    ConcurrentNode* parent;
+    ConcurrentNode* leaf;
+} SeekRecord;
+
+static ConcurrentNode* edgeNode(uintptr_t edge) {
+    return (ConcurrentNode*)(edge & ~EDGE_MARKS);
+}
+
+static bool isLeaf(ConcurrentNode* node) {
+    return atomic_load_explicit(&node->left, memory_order_acquire) == 0;
+}
+
+/**
+ * Child edge of node that key is routed through
+ */
+static _Atomic(uintptr_t)* childLink(ConcurrentNode* node, long long key) {
+    return key < node->key ? &node->left : &node->right;
+}
+
+static _Atomic(uintptr_t)* otherLink(ConcurrentNode* node, _Atomic(uintptr_t)* link) {
+    return link == &node->left ? &node->right : &node->left;
+}
+
+static ConcurrentNode* createConcurrentNode(long long key, ConcurrentNode* left, ConcurrentNode* right) {
+    ConcurrentNode* node = (ConcurrentNode*)malloc(sizeof(ConcurrentNode));
+    if (node) {
+        node->key = key;
+        atomic_init(&node->left, (uintptr_t)left);
+        atomic_init(&node->right, (uintptr_t)right);
+    }
+    return node;
+}
+
+/**
+ * Walks to the leaf key is routed to, remembering the last clean edge
+ * Must run inside epochEnter()/epochExit()
+ */
+static void concurrentSeek(ConcurrentTree* tree, long long key, SeekRecord* seek) {
+    ConcurrentNode* sentinel = edgeNode(atomic_load(&tree->root->left));
+    seek->ancestor = tree->root;
+    seek->successor = sentinel;
+    seek->parent = sentinel;
+    uintptr_t parentEdge = atomic_load_explicit(&sentinel->left, memory_order_acquire);
+    seek->leaf = edgeNode(parentEdge);
+    uintptr_t currentEdge = atomic_load_explicit(childLink(seek->leaf, key), memory_order_acquire);
+    ConcurrentNode* current = edgeNode(currentEdge);
+
+    while (current) {
+        if (!(parentEdge & EDGE_TAG)) {
+            seek->ancestor = seek->parent;
+            seek->successor = seek->leaf;
+        }
+        seek->parent = seek->leaf;
+        seek->leaf = current;
+        parentEdge = currentEdge;
+        currentEdge = atomic_load_explicit(childLink(current, key), memory_order_acquire);
+        current = edgeNode(currentEdge);
+    }
+}
+
+/**
+ * Retires everything a successful cleanup unlinked: each node from the
+ * successor down to the parent, and the flagged leaf hanging off each
+ * kept is the parent's edge that was moved up
+ */
+static void retireUnlinked(HazardRecord* record, SeekRecord* seek, long long key,
+                           _Atomic(uintptr_t)* kept) {
+    // Edges below the successor are tagged or flagged, so they no longer change
+    ConcurrentNode* node = seek->successor;
+    while (node != seek->parent) {
+        _Atomic(uintptr_t)* down = childLink(node, key);
+        ConcurrentNode* next = edgeNode(atomic_load(down));
+        epochRetire(record, edgeNode(atomic_load(otherLink(node, down))));
+        epochRetire(record, node);
+        node = next;
+    }
+    epochRetire(record, edgeNode(atomic_load(otherLink(node, kept))));
+    epochRetire(record, node);
+}
+
+/**
+ * Unlinks the flagged leaf below seek->parent by tagging its sibling edge
+ * and swinging the ancestor's edge to that sibling
+ * Returns true if this call made the change
+ */
+static bool concurrentCleanup(HazardRecord* record, SeekRecord* seek, long long key) {
+    ConcurrentNode* parent = seek->parent;
+    _Atomic(uintptr_t)* successorLink = childLink(seek->ancestor, key);
+    _Atomic(uintptr_t)* childEdge = childLink(parent, key);
+    _Atomic(uintptr_t)* siblingEdge = otherLink(parent, childEdge);
+    if (!(atomic_load(childEdge) & EDGE_FLAG)) {
+        // The leaf on our path stays; it is its sibling that is being deleted
+        siblingEdge = childEdge;
+    }
+
+    // Once tagged the sibling edge cannot change, so it is safe to move up
+    uintptr_t sibling = atomic_fetch_or(siblingEdge, EDGE_TAG);
+    uintptr_t expected = (uintptr_t)seek->successor;
+    if (!atomic_compare_exchange_strong(successorLink, &expected, sibling & ~EDGE_TAG)) {
+        return false;
+    }
+    retireUnlinked(record, seek, key, siblingEdge);
+    return true;
+}
+
+/**
+ * Creates an empty tree that many threads may search and update at once
+ */
+ConcurrentTree* bst_concurrent_create(void) {
+    ConcurrentTree* tree = (ConcurrentTree*)malloc(sizeof(ConcurrentTree));
+    ConcurrentNode* inf0 = createConcurrentNode(KEY_INF0, NULL, NULL);
+    ConcurrentNode* inf1 = createConcurrentNode(KEY_INF1, NULL, NULL);
+    ConcurrentNode* inf2 = createConcurrentNode(KEY_INF2, NULL, NULL);
+    ConcurrentNode* sentinel = inf0 && inf1 ? createConcurrentNode(KEY_INF1, inf0, inf1) : NULL;
+    ConcurrentNode* root = sentinel && inf2 ? createConcurrentNode(KEY_INF2, sentinel, inf2) : NULL;
+    if (!tree || !root) {
+        printf("Error: Memory allocation failed for concurrent tree\n");
+        free(tree);
+        free(inf0);
+        free(inf1);
+        free(inf2);
+        free(sentinel);
+        return NULL;
+    }
+    tree->root = root;
+    return tree;
+}
+
+/**
+ * Returns true if key is in the tree; never blocks or retries
+ */
+bool bst_concurrent_search(ConcurrentTree* tree, int key) {
+    HazardRecord* record = hazardRecord();
+    if (!record) {
+        return false;
+    }
+    epochEnter(record);
+    ConcurrentNode* node = tree->root;
+    while (!isLeaf(node)) {
+        node = edgeNode(atomic_load_explicit(childLink(node, key), memory_order_acquire));
+    }
+    bool found = node->key == key;
+    epochExit(record);
+    return found;
+}
+
+/**
+ * Inserts key by swapping the leaf it lands on for a two-leaf subtree
+ * with one CAS; helps a delete in the way finish and retries
+ * Returns 0, or -1 if key is already present or allocation fails
+ */
+int bst_concurrent_insert(ConcurrentTree* tree, int key) {
+    HazardRecord* record = hazardRecord();
+    if (!record) {
+        return -1;
+    }
+
+    ConcurrentNode* added = NULL;
+    ConcurrentNode* internal = NULL;
+    SeekRecord seek;
+    epochEnter(record);
+    for (;;) {
+        concurrentSeek(tree, key, &seek);
+        ConcurrentNode* leaf = seek.leaf;
+        if (leaf->key == key) {
+            free(added);
+            free(internal);
+            epochExit(record);
+            return -1;
+        }
+        if (!internal) {
+            added = createConcurrentNode(key, NULL, NULL);
+            internal = createConcurrentNode(0, NULL, NULL);
+            if (!added || !internal) {
+                free(added);
+                free(internal);
+                epochExit(record);
+                return -1;
+            }
+        }
+        // Not yet published, so plain stores are enough
+        internal->key = key < leaf->key ? leaf->key : key;
+        atomic_store_explicit(&internal->left, (uintptr_t)(key < leaf->key ? added : leaf),
+                              memory_order_relaxed);
+        atomic_store_explicit(&internal->right, (uintptr_t)(key < leaf->key ? leaf : added),
+                              memory_order_relaxed);
+
+        _Atomic(uintptr_t)* link = childLink(seek.parent, key);
+        uintptr_t expected = (uintptr_t)leaf;
+        if (atomic_compare_exchange_strong(link, &expected, (uintptr_t)internal)) {
+            break;
+        }
+        if (edgeNode(expected) == leaf && (expected & EDGE_MARKS)) {
+            concurrentCleanup(record, &seek, key);
+        }
+    }
+    epochExit(record);
+    return 0;
+}
+
+/**
+ * Removes key: flags the edge to its leaf, then unlinks the leaf and its
+ * parent; any thread that runs into the flag finishes the unlink
+ * Returns 0, or -1 if key is not in the tree
+ */
+int bst_concurrent_Delete_Node(ConcurrentTree* tree, int key) {
+    HazardRecord* record = hazardRecord();
+    if (!record) {
+        return -1;
+    }
+
+    ConcurrentNode* flagged = NULL;     // Our leaf, once the flag is in place
+    SeekRecord seek;
+    epochEnter(record);
+    for (;;) {
+        concurrentSeek(tree, key, &seek);
+        if (flagged) {
+            // The key is ours to delete; stop once someone has unlinked it
+            if (seek.leaf != flagged || concurrentCleanup(record, &seek, key)) {
+                break;
+            }
+            continue;
+        }
+
+        ConcurrentNode* leaf = seek.leaf;
+        if (leaf->key != key) {
+            epochExit(record);
+            return -1;
+        }
+        _Atomic(uintptr_t)* link = childLink(seek.parent, key);
+        uintptr_t expected = (uintptr_t)leaf;
+        if (atomic_compare_exchange_strong(link, &expected, expected | EDGE_FLAG)) {
+            flagged = leaf;
+            if (concurrentCleanup(record, &seek, key)) {
+                break;
+            }
+        } else if (edgeNode(expected) == leaf && (expected & EDGE_MARKS)) {
+            concurrentCleanup(record, &seek, key);
+        }
+    }
+    epochExit(record);
+    return 0;
+}
+
+/**
+ * Frees the tree; no other thread may still use it
+ * Also frees the nodes earlier deletes retired, including those of
+ * threads that have exited, unless a reader elsewhere could still see them
+ */
+void bst_concurrent_free(ConcurrentTree* tree) {
+    if (!tree) {
+        return;
+    }
+    ConcurrentNode* node = tree->root;
+    // Morris-style teardown: rotate left children up so no stack is needed
+    while (node) {
+        ConcurrentNode* left = edgeNode(atomic_load(&node->left));
+        if (left) {
+            atomic_store(&node->left, atomic_load(&left->right));
+            atomic_store(&left->right, (uintptr_t)node);
+            node = left;
+        } else {
+            ConcurrentNode* right = edgeNode(atomic_load(&node->right));
+            free(node);
+            node = right;
+        }
+    }
+    free(tree);
+
+    HazardRecord* record = hazardRecord();
+    if (record) {
+        // A node retired now is free once the epoch has moved on twice
+        epochReclaim(record);
+        epochReclaim(record);
+    }
+}
@@ -0,0 +1,210 @@
+#include "dshelp.h"
+/* ====================
+ * MEMORY POOL
+ * ==================== */
+
+// Objects per slab when the caller passes 0
+#define POOL_DEFAULT_SLAB_OBJECTS 1024
+#define POOL_CACHE_LINE 64
+
+/*Header of every slab; the objects follow it in the same allocation*/
+struct PoolSlab {
+    struct PoolSlab* next;   // Next slab in allocation order
+    size_t capacity;         // Number of objects in this slab
+};
+
+/**
+ * Size of the slab header, rounded up so objects keep pointer alignment
+ */
+static size_t slabHeaderSize(void) {
+    return (sizeof(PoolSlab) + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*);
+}
+
+/**
+ * Objects that fill whole cache lines start on a line boundary,
+ * everything else only needs pointer alignment
+ */
+static size_t poolAlignment(const NodePool* pool) {
+    return pool->objectSize % POOL_CACHE_LINE == 0 ? POOL_CACHE_LINE : sizeof(void*);
+}
+
+/**
+ * Allocates an unlinked slab with room for capacity objects
+ */
+static PoolSlab* allocSlab(NodePool* pool, size_t capacity) {
+    // The header keeps pointer alignment, so at most this much padding is needed
+    size_t padding = poolAlignment(pool) - sizeof(void*);
+    PoolSlab* slab = (PoolSlab*)malloc(slabHeaderSize() + padding + capacity * pool->objectSize);
+    if (slab) {
+        slab->next = NULL;
+        slab->capacity = capacity;
+    }
+    return slab;
+}
+
+/**
+ * Points the cursor at the first object of slab
+ */
+static void useSlab(NodePool* pool, PoolSlab* slab) {
+    uintptr_t first = (uintptr_t)slab + slabHeaderSize();
+    uintptr_t mask = (uintptr_t)poolAlignment(pool) - 1;
+    pool->current = slab;
+    pool->cursor = (char*)((first + mask) & ~mask);
+    pool->end = pool->cursor + slab->capacity * pool->objectSize;
+}
+
+/**
+ * Creates a pool handing out fixed-size objects carved from large slabs
+ * objectsPerSlab may be 0 to use the default slab size
+ * Objects whose size is a multiple of 64 bytes start on a cache line
+ */
+NodePool* createNodePool(size_t objectSize, size_t objectsPerSlab) {
+    if (objectSize == 0) {
+        printf("Error: Pool object size must be positive\n");
+        return NULL;
+    }
+
+    NodePool* pool = (NodePool*)malloc(sizeof(NodePool));
+    if (!pool) {
+        printf("Error: Memory allocation failed for pool\n");
+        return NULL;
+    }
+
+    // Every object must be able to hold the free list link
+    if (objectSize < sizeof(void*)) {
+        objectSize = sizeof(void*);
+    }
+    pool->objectSize = (objectSize + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*);
+    pool->slabObjects = objectsPerSlab ? objectsPerSlab : POOL_DEFAULT_SLAB_OBJECTS;
+    pool->slabs = NULL;
+    pool->current = NULL;
+    pool->cursor = NULL;
+    pool->end = NULL;
+    pool->freeList = NULL;
+    return pool;
+}
+
+/**
+ * Allocates one object from the pool
+ * Reuses freed objects first, then bumps through the current slab and
+ * only calls malloc when every slab is used up
+ * A NULL pool falls back to malloc; returns NULL if allocation fails or
+ * objectSize is larger than the pool's slots
+ */
+void* poolAlloc(NodePool* pool, size_t objectSize) {
+    if (!pool) {
+        return malloc(objectSize);
+    }
+    if (objectSize > pool->objectSize) {
+        return NULL;
+    }
+
+    if (pool->freeList) {
+        void* object = pool->freeList;
+        pool->freeList = *(void**)object;
+        return object;
+    }
+
+    if (pool->cursor == pool->end) {
+        // Move on to a slab kept by poolReset() or allocate a new one
+        PoolSlab* slab = pool->current ? pool->current->next : pool->slabs;
+        if (!slab) {
+            slab = allocSlab(pool, pool->slabObjects);
+            if (!slab) {
+                return NULL;
+            }
+            if (pool->current) {
+                pool->current->next = slab;
+            } else {
+                pool->slabs = slab;
+            }
+        }
+        useSlab(pool, slab);
+    }
+
+    void* object = pool->cursor;
+    pool->cursor += pool->objectSize;
+    return object;
+}
+
+/**
+ * Allocates count objects that sit next to each other in one slab
+ * Objects can later be returned one at a time with poolFree()
+ * Returns NULL if count is 0, pool is NULL or allocation fails
+ */
+void* poolAllocMany(NodePool* pool, size_t count) {
+    if (!pool || count == 0) {
+        return NULL;
+    }
+
+    size_t room = (size_t)(pool->end - pool->cursor) / pool->objectSize;
+    if (room < count) {
+        // Skip ahead to a large enough kept slab, or splice in a new one
+        PoolSlab* slab = pool->current ? pool->current->next : pool->slabs;
+        if (!slab || slab->capacity < count) {
+            size_t capacity = count > pool->slabObjects ? count : pool->slabObjects;
+            PoolSlab* fresh = allocSlab(pool, capacity);
+            if (!fresh) {
+                return NULL;
+            }
+            fresh->next = slab;
+            if (pool->current) {
+                pool->current->next = fresh;
+            } else {
+                pool->slabs = fresh;
+            }
+            slab = fresh;
+        }
+        useSlab(pool, slab);
+    }
+
+    void* objects = pool->cursor;
+    pool->cursor += count * pool->objectSize;
+    return objects;
+}
+
+/**
+ * Returns one object to the pool for reuse
+ * A NULL pool falls back to free
+ */
+void poolFree(NodePool* pool, void* object) {
+    if (!object) {
+        return;
+    }
+    if (!pool) {
+        free(object);
+        return;
+    }
+    *(void**)object = pool->freeList;
+    pool->freeList = object;
+}
+
+/**
+ * Releases every object of the pool in O(1)
+ * The slabs are kept and refilled by later allocations
+ */
+void poolReset(NodePool* pool) {
+    if (!pool) {
+        return;
+    }
+    pool->current = NULL;
+    pool->cursor = NULL;
+    pool->end = NULL;
+    pool->freeList = NULL;
+}
+
+/**
+ * Frees the pool together with all of its slabs
+ */
+void freeNodePool(NodePool* pool) {
+    if (!pool) {
+        return;
+    }
+    PoolSlab* slab = pool->slabs;
+    while (slab) {
+        PoolSlab* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    free(pool);
+}
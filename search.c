@@ -0,0 +1,309 @@
+#include "dshelp.h"
+#include <stdatomic.h>
+/* ====================
+ * SEARCH KERNELS
+ * ==================== */
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SEARCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC allows every intrinsic without per-function target flags
+#define TARGET_AVX2
+#define TARGET_SSE2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#endif
+#endif
+
+// Kernel picked on first use; 0 until the CPU has been checked
+enum { SEARCH_UNKNOWN, SEARCH_SCALAR, SEARCH_SSE2, SEARCH_AVX2 };
+static atomic_int searchLevel = SEARCH_UNKNOWN;
+
+/**
+ * Portable kernels, also used for the tail of every vector scan
+ */
+static int searchScalar(const int* values, int count, int key) {
+    for (int i = 0; i < count; i++) {
+        if (values[i] == key) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int searchLastScalar(const int* values, int count, int key) {
+    for (int i = count - 1; i >= 0; i--) {
+        if (values[i] == key) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int countLessScalar(const int* values, int count, int key) {
+    int less = 0;
+    for (int i = 0; i < count; i++) {
+        less += values[i] < key;
+    }
+    return less;
+}
+
+#ifdef SEARCH_X86
+/**
+ * Number of set bits in a lane mask
+ */
+static int bitCount(unsigned mask) {
+#if defined(_MSC_VER)
+    int bits = 0;
+    for (; mask; mask &= mask - 1) {
+        bits++;
+    }
+    return bits;
+#else
+    return __builtin_popcount(mask);
+#endif
+}
+
+/**
+ * Index of the lowest / highest set bit of a non-zero mask
+ */
+static int lowestBit(unsigned mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+static int highestBit(unsigned mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (int)index;
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
+
+/**
+ * Bit i of the mask is set when lane i equals the key
+ */
+TARGET_AVX2 static unsigned matchAvx2(const int* values, __m256i key) {
+    __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)values), key);
+    return (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq));
+}
+
+TARGET_SSE2 static unsigned matchSse2(const int* values, __m128i key) {
+    __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)values), key);
+    return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq));
+}
+
+/**
+ * AVX2 kernels: 16 keys per iteration, then 8, then the scalar tail
+ */
+TARGET_AVX2 static int searchAvx2(const int* values, int count, int key) {
+    __m256i k = _mm256_set1_epi32(key);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        unsigned mask = matchAvx2(values + i, k) | matchAvx2(values + i + 8, k) << 8;
+        if (mask) {
+            return i + lowestBit(mask);
+        }
+    }
+    for (; i + 8 <= count; i += 8) {
+        unsigned mask = matchAvx2(values + i, k);
+        if (mask) {
+            return i + lowestBit(mask);
+        }
+    }
+    int found = searchScalar(values + i, count - i, key);
+    return found < 0 ? -1 : i + found;
+}
+
+TARGET_AVX2 static int searchLastAvx2(const int* values, int count, int key) {
+    __m256i k = _mm256_set1_epi32(key);
+    int i = count;
+    for (; i >= 16; i -= 16) {
+        unsigned mask = matchAvx2(values + i - 16, k) | matchAvx2(values + i - 8, k) << 8;
+        if (mask) {
+            return i - 16 + highestBit(mask);
+        }
+    }
+    for (; i >= 8; i -= 8) {
+        unsigned mask = matchAvx2(values + i - 8, k);
+        if (mask) {
+            return i - 8 + highestBit(mask);
+        }
+    }
+    return searchLastScalar(values, i, key);
+}
+
+TARGET_AVX2 static int countLessAvx2(const int* values, int count, int key) {
+    __m256i k = _mm256_set1_epi32(key);
+    int less = 0, i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i lt = _mm256_cmpgt_epi32(k, _mm256_loadu_si256((const __m256i*)(values + i)));
+        less += bitCount((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(lt)));
+    }
+    return less + countLessScalar(values + i, count - i, key);
+}
+
+/**
+ * SSE2 kernels: same shape as the AVX2 ones with 4-lane compares
+ */
+TARGET_SSE2 static int searchSse2(const int* values, int count, int key) {
+    __m128i k = _mm_set1_epi32(key);
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        unsigned mask = matchSse2(values + i, k) | matchSse2(values + i + 4, k) << 4 |
+                        matchSse2(values + i + 8, k) << 8 | matchSse2(values + i + 12, k) << 12;
+        if (mask) {
+            return i + lowestBit(mask);
+        }
+    }
+    for (; i + 4 <= count; i += 4) {
+        unsigned mask = matchSse2(values + i, k);
+        if (mask) {
+            return i + lowestBit(mask);
+        }
+    }
+    int found = searchScalar(values + i, count - i, key);
+    return found < 0 ? -1 : i + found;
+}
+
+TARGET_SSE2 static int searchLastSse2(const int* values, int count, int key) {
+    __m128i k = _mm_set1_epi32(key);
+    int i = count;
+    for (; i >= 16; i -= 16) {
+        unsigned mask = matchSse2(values + i - 16, k) | matchSse2(values + i - 12, k) << 4 |
+                        matchSse2(values + i - 8, k) << 8 | matchSse2(values + i - 4, k) << 12;
+        if (mask) {
+            return i - 16 + highestBit(mask);
+        }
+    }
+    for (; i >= 4; i -= 4) {
+        unsigned mask = matchSse2(values + i - 4, k);
+        if (mask) {
+            return i - 4 + highestBit(mask);
+        }
+    }
+    return searchLastScalar(values, i, key);
+}
+
+TARGET_SSE2 static int countLessSse2(const int* values, int count, int key) {
+    __m128i k = _mm_set1_epi32(key);
+    int less = 0, i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i lt = _mm_cmpgt_epi32(k, _mm_loadu_si128((const __m128i*)(values + i)));
+        less += bitCount((unsigned)_mm_movemask_ps(_mm_castsi128_ps(lt)));
+    }
+    return less + countLessScalar(values + i, count - i, key);
+}
+
+/**
+ * Best kernel level the CPU and OS support
+ */
+static int detectSearchLevel(void) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    // AVX2 also needs the OS to save the YMM registers (OSXSAVE + XCR0)
+    bool osAvx = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+    if (maxLeaf >= 7 && osAvx) {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5)) {
+            return SEARCH_AVX2;
+        }
+    }
+    return SEARCH_SSE2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SEARCH_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SEARCH_SSE2;
+    }
+    return SEARCH_SCALAR;
+#endif
+}
+#endif
+
+static int currentSearchLevel(void) {
+    int level = atomic_load_explicit(&searchLevel, memory_order_relaxed);
+    if (level == SEARCH_UNKNOWN) {
+#ifdef SEARCH_X86
+        level = detectSearchLevel();
+#else
+        level = SEARCH_SCALAR;
+#endif
+        atomic_store_explicit(&searchLevel, level, memory_order_relaxed);
+    }
+    return level;
+}
+
+/**
+ * Index of the first value equal to key, or -1 if there is none
+ * Uses the widest vector kernel the CPU supports
+ */
+int searchInts(const int* values, int count, int key) {
+    if (!values || count <= 0) {
+        return -1;
+    }
+    switch (currentSearchLevel()) {
+#ifdef SEARCH_X86
+    case SEARCH_AVX2:
+        return searchAvx2(values, count, key);
+    case SEARCH_SSE2:
+        return searchSse2(values, count, key);
+#endif
+    default:
+        return searchScalar(values, count, key);
+    }
+}
+
+/**
+ * Index of the last value equal to key, or -1 if there is none
+ */
+int searchIntsLast(const int* values, int count, int key) {
+    if (!values || count <= 0) {
+        return -1;
+    }
+    switch (currentSearchLevel()) {
+#ifdef SEARCH_X86
+    case SEARCH_AVX2:
+        return searchLastAvx2(values, count, key);
+    case SEARCH_SSE2:
+        return searchLastSse2(values, count, key);
+#endif
+    default:
+        return searchLastScalar(values, count, key);
+    }
+}
+
+/**
+ * Number of values below key
+ * On a sorted array this is the index of the first value not below key
+ */
+int countLessInts(const int* values, int count, int key) {
+    if (!values || count <= 0) {
+        return 0;
+    }
+    switch (currentSearchLevel()) {
+#ifdef SEARCH_X86
+    case SEARCH_AVX2:
+        return countLessAvx2(values, count, key);
+    case SEARCH_SSE2:
+        return countLessSse2(values, count, key);
+#endif
+    default:
+        return countLessScalar(values, count, key);
+    }
+}
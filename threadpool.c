@@ -0,0 +1,172 @@
+#include "dshelp.h"
+#include <pthread.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+/* ====================
+ * THREAD POOL
+ * ==================== */
+
+/*Fork-join pool: every run executes one task on all threads and waits*/
+struct ThreadPool {
+    int numThreads;          // Worker threads plus the calling thread
+    pthread_t* workers;      // numThreads - 1 background threads
+    pthread_mutex_t lock;
+    pthread_cond_t start;    // Signalled when a new task is published
+    pthread_cond_t done;     // Signalled when the last worker finishes
+    ThreadTask task;         // Task of the current run
+    void* arg;               // Argument of the current run
+    unsigned long generation;// Incremented for every run
+    int pending;             // Workers still running the current task
+    bool shutdown;           // Set when the pool is being freed
+};
+
+/*Argument passed to each background thread*/
+typedef struct WorkerStart {
+    ThreadPool* pool;
+    int index;
+} WorkerStart;
+
+/**
+ * Background thread loop: waits for a new generation, runs the task
+ * with its own index and reports completion
+ */
+static void* workerMain(void* param) {
+    WorkerStart start = *(WorkerStart*)param;
+    free(param);
+    ThreadPool* pool = start.pool;
+    unsigned long seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        seen = pool->generation;
+        ThreadTask task = pool->task;
+        void* arg = pool->arg;
+        pthread_mutex_unlock(&pool->lock);
+
+        task(arg, start.index, pool->numThreads);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * Creates a pool of numThreads threads, the calling thread included
+ * Passing 0 uses one thread per online processor where that is known
+ */
+ThreadPool* createThreadPool(int numThreads) {
+    if (numThreads <= 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+        numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+        if (numThreads <= 0) {
+            numThreads = 1;
+        }
+    }
+
+    ThreadPool* pool = (ThreadPool*)malloc(sizeof(ThreadPool));
+    if (!pool) {
+        printf("Error: Memory allocation failed for thread pool\n");
+        return NULL;
+    }
+    pool->numThreads = numThreads;
+    pool->task = NULL;
+    pool->arg = NULL;
+    pool->generation = 0;
+    pool->pending = 0;
+    pool->shutdown = false;
+    pool->workers = (pthread_t*)malloc((numThreads > 1 ? numThreads - 1 : 1) * sizeof(pthread_t));
+    if (!pool->workers) {
+        printf("Error: Memory allocation failed for thread pool\n");
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    for (int i = 1; i < numThreads; i++) {
+        WorkerStart* start = (WorkerStart*)malloc(sizeof(WorkerStart));
+        if (start) {
+            start->pool = pool;
+            start->index = i;
+        }
+        if (!start || pthread_create(&pool->workers[i - 1], NULL, workerMain, start) != 0) {
+            printf("Error: Could not start thread pool worker %d\n", i);
+            free(start);
+            // Keep the threads that did start
+            pool->numThreads = i;
+            break;
+        }
+    }
+    return pool;
+}
+
+/**
+ * Returns the number of threads that take part in every run
+ */
+int threadPoolSize(ThreadPool* pool) {
+    return pool ? pool->numThreads : 1;
+}
+
+/**
+ * Runs task(arg, index, numThreads) once on every thread of the pool and
+ * returns when all of them have finished; the caller runs index 0
+ * A NULL pool runs the task on the calling thread only
+ */
+void threadPoolRun(ThreadPool* pool, ThreadTask task, void* arg) {
+    if (!pool || pool->numThreads == 1) {
+        task(arg, 0, 1);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->arg = arg;
+    pool->pending = pool->numThreads - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    task(arg, 0, pool->numThreads);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Stops all workers and frees the pool
+ */
+void freeThreadPool(ThreadPool* pool) {
+    if (!pool) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 1; i < pool->numThreads; i++) {
+        pthread_join(pool->workers[i - 1], NULL);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+    free(pool->workers);
+    free(pool);
+}
@@ -80,6 +80,7 @@ class BSTVisualizer:
         Tree._fields_ = [
             ("left", ctypes.POINTER(Tree)),
             ("data", ctypes.c_int),
+            ("height", ctypes.c_int),  # Fills the padding before right
             ("right", ctypes.POINTER(Tree))
         ]
         
@@ -52,6 +52,7 @@ class GraphVisualizer:
         self.edges = []  # Python-side edge list for visualization [(src, dest, weight)]
         self._redraw_pending = False  # Flag to prevent excessive redraws
         self.traversal_path = []  # Store current traversal path for highlighting
+        self.has_into = False  # True when the DLL exports bfsInto/dfsInto
         
         # Setup ctypes if DLL is available
         if dll:
@@ -79,7 +80,8 @@ class GraphVisualizer:
             _fields_ = [
                 ("numVertices", ctypes.c_int),
                 ("adjLists", ctypes.POINTER(ctypes.POINTER(Node))),
-                ("visited", ctypes.POINTER(ctypes.c_bool))
+                ("visited", ctypes.c_void_p),
+                ("nodePool", ctypes.c_void_p)
             ]
         
         self.Graph = Graph
@@ -104,6 +106,18 @@ class GraphVisualizer:
         dll.dfs.argtypes = [ctypes.POINTER(Graph), ctypes.c_int]
         dll.dfs.restype = None
         
+        # Result-returning traversals (only in DLLs built from current sources)
+        int_array = ctypes.POINTER(ctypes.c_int)
+        self.has_into = hasattr(dll, "bfsInto") and hasattr(dll, "dfsInto")
+        if self.has_into:
+            dll.bfsInto.argtypes = [ctypes.POINTER(Graph), ctypes.c_int, ctypes.c_void_p,
+                                    int_array, int_array, int_array]
+            dll.bfsInto.restype = ctypes.c_int
+            
+            dll.dfsInto.argtypes = [ctypes.POINTER(Graph), ctypes.c_int, ctypes.c_void_p,
+                                    int_array, int_array]
+            dll.dfsInto.restype = ctypes.c_int
+        
     def create_ui(self, parent):
         """
         Create the user interface with controls and canvas.
@@ -321,10 +335,74 @@ class GraphVisualizer:
         except Exception as e:
             messagebox.showerror("Error", f"Remove edge failed: {str(e)}")
             
+    def python_bfs(self, start):
+        """
+        Python-side BFS over the edge list, used when the DLL predates bfsInto.
+        
+        Args:
+            start: Starting vertex
+        
+        Returns:
+            List of vertices in visit order
+        """
+        # Build adjacency list from edges
+        adj_list = {i: [] for i in range(self.num_vertices)}
+        for src, dest, weight in self.edges:
+            adj_list[src].append(dest)
+        
+        # Perform BFS
+        visited = [False] * self.num_vertices
+        queue = [start]
+        visited[start] = True
+        traversal_order = []
+        
+        while queue:
+            vertex = queue.pop(0)
+            traversal_order.append(vertex)
+            
+            # Add unvisited neighbors to queue
+            for neighbor in adj_list[vertex]:
+                if not visited[neighbor]:
+                    visited[neighbor] = True
+                    queue.append(neighbor)
+        return traversal_order
+        
+    def python_dfs(self, start):
+        """
+        Python-side DFS over the edge list, used when the DLL predates dfsInto.
+        
+        Args:
+            start: Starting vertex
+        
+        Returns:
+            List of vertices in visit order
+        """
+        # Build adjacency list from edges
+        adj_list = {i: [] for i in range(self.num_vertices)}
+        for src, dest, weight in self.edges:
+            adj_list[src].append(dest)
+        
+        # Perform DFS using recursion
+        visited = [False] * self.num_vertices
+        traversal_order = []
+        
+        def dfs_util(vertex):
+            visited[vertex] = True
+            traversal_order.append(vertex)
+            
+            # Visit all unvisited neighbors
+            for neighbor in adj_list[vertex]:
+                if not visited[neighbor]:
+                    dfs_util(neighbor)
+        
+        dfs_util(start)
+        return traversal_order
+        
     def bfs_traversal(self):
         """
         Perform BFS traversal starting from a vertex.
-        Uses Python-side implementation to work with the edge list.
+        Uses bfsInto from the C library, falling back to a Python-side
+        implementation over the edge list.
         """
         if self.num_vertices == 0:
             messagebox.showwarning("Warning", "Please create a graph first")
@@ -333,26 +411,13 @@ class GraphVisualizer:
         try:
             start = simpledialog.askinteger("BFS", "Enter starting vertex:", minvalue=0, maxvalue=self.num_vertices - 1)
             if start is not None:
-                # Build adjacency list from edges
-                adj_list = {i: [] for i in range(self.num_vertices)}
-                for src, dest, weight in self.edges:
-                    adj_list[src].append(dest)
-                
-                # Perform BFS
-                visited = [False] * self.num_vertices
-                queue = [start]
-                visited[start] = True
-                traversal_order = []
-                
-                while queue:
-                    vertex = queue.pop(0)
-                    traversal_order.append(vertex)
-                    
-                    # Add unvisited neighbors to queue
-                    for neighbor in adj_list[vertex]:
-                        if not visited[neighbor]:
-                            visited[neighbor] = True
-                            queue.append(neighbor)
+                if dll and self.graph and self.has_into:
+                    # Let the C library fill the visit order directly
+                    order = (ctypes.c_int * self.num_vertices)()
+                    count = dll.bfsInto(self.graph, start, None, order, None, None)
+                    traversal_order = list(order[:max(count, 0)])
+                else:
+                    traversal_order = self.python_bfs(start)
                 
                 # Store traversal path for visualization
                 self.traversal_path = traversal_order
@@ -382,7 +447,8 @@ class GraphVisualizer:
     def dfs_traversal(self):
         """
         Perform DFS traversal starting from a vertex.
-        Uses Python-side implementation to work with the edge list.
+        Uses dfsInto from the C library, falling back to a Python-side
+        implementation over the edge list.
         """
         if self.num_vertices == 0:
             messagebox.showwarning("Warning", "Please create a graph first")
@@ -391,25 +457,13 @@ class GraphVisualizer:
         try:
             start = simpledialog.askinteger("DFS", "Enter starting vertex:", minvalue=0, maxvalue=self.num_vertices - 1)
             if start is not None:
-                # Build adjacency list from edges
-                adj_list = {i: [] for i in range(self.num_vertices)}
-                for src, dest, weight in self.edges:
-                    adj_list[src].append(dest)
-                
-                # Perform DFS using recursion
-                visited = [False] * self.num_vertices
-                traversal_order = []
-                
-                def dfs_util(vertex):
-                    visited[vertex] = True
-                    traversal_order.append(vertex)
-                    
-                    # Visit all unvisited neighbors
-                    for neighbor in adj_list[vertex]:
-                        if not visited[neighbor]:
-                            dfs_util(neighbor)
-                
-                dfs_util(start)
+                if dll and self.graph and self.has_into:
+                    # Let the C library fill the visit order directly
+                    order = (ctypes.c_int * self.num_vertices)()
+                    count = dll.dfsInto(self.graph, start, None, order, None)
+                    traversal_order = list(order[:max(count, 0)])
+                else:
+                    traversal_order = self.python_dfs(start)
                 
                 # Store traversal path for visualization
                 self.traversal_path = traversal_order